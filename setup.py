@@ -59,11 +59,44 @@ extensions = [
         "pseudoflow.libhpf",
         ["src/pseudoflow/core/libhpf.c"],
         depends=["src/pseudoflow/core/libhpf.h"],
-        export_symbols=["hpf_solve", "libfree"],
+        export_symbols=[
+            "hpf_solve",
+            "hpf_context_create",
+            "hpf_context_set_option",
+            "hpf_context_set_callback",
+            "hpf_context_set_range_cuts",
+            "hpf_context_set_flow_lambda",
+            "hpf_context_solve",
+            "hpf_context_solve_arrays",
+            "hpf_context_solve_arrays64",
+            "hpf_context_solve_lambdas",
+            "hpf_context_solve_file",
+            "hpf_solve_batch",
+            "hpf_graph_create",
+            "hpf_graph_context",
+            "hpf_graph_set_capacities",
+            "hpf_graph_solve",
+            "hpf_graph_destroy",
+            "hpf_write_graph",
+            "hpf_context_get_stat",
+            "hpf_context_get_phase_time",
+            "hpf_context_get_level",
+            "hpf_context_get_cut_values",
+            "hpf_context_get_flows",
+            "hpf_context_destroy",
+            "libfree",
+        ],
         # include_dirs=["pseudoflow/core"],
         language="c99",
         extra_compile_args=["-std=c99", "-O3"],
-    )
+    ),
+    # native entry of pseudoflow.hpf, with its own copy of the solver
+    Extension(
+        "pseudoflow._hpf",
+        ["src/pseudoflow/python/_hpfmodule.c", "src/pseudoflow/core/libhpf.c"],
+        depends=["src/pseudoflow/core/libhpf.h"],
+        extra_compile_args=["-O3"],
+    ),
 ]
 
 
@@ -1 +1 @@
-from pseudoflow.python.hpf import hpf
+from pseudoflow.python.hpf import hpf, hpf_arrays, hpf_batch
@@ -0,0 +1,185 @@
+/*************************************************************************
+ * Grid benchmark for the HPF parametric minimum cut solver              *
+ * ***********************************************************************
+ * Builds a 4-connected <side> x <side> grid graph as it appears in      *
+ * image segmentation and solves its parametric cut over a lambda range. *
+ * Every pixel has a source adjacent arc with capacity                   *
+ * <grey value> + lambda and a sink adjacent arc with a constant         *
+ * capacity. Neighbouring pixels are joined by arcs in both directions.  *
+ * The grey values form a piecewise constant image of BLOCK x BLOCK      *
+ * squares with LEVELS values, generated with a fixed seed, so the       *
+ * instance only depends on <side>.                                      *
+ *                                                                       *
+ * Usage:																 *
+ *	 grid <side> [<repeats> [<region threads>]]							 *
+ *                                                                       *
+ * The benchmark reports the wall clock time of every repeat and the     *
+ * counters of the last solve. Cache misses can be measured by running   *
+ * it under a profiler, e.g. make perf SIDE=<side>.                      *
+ *************************************************************************/
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "time.h"
+#include "../core/libhpf.h"
+
+#define LEVELS 8
+#define BLOCK 32
+
+static unsigned int seed = 12345;
+
+static double nextRandom(void)
+/*************************************************************************
+nextRandom - Uniform number in [0, 1) from a fixed xorshift sequence
+*************************************************************************/
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return (seed & 0xFFFFFF) / (double) 0x1000000;
+}
+
+static double wallTime(void)
+/*************************************************************************
+wallTime - Seconds since an arbitrary point, also with several threads
+*************************************************************************/
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static void setArc(double *arcMatrix, int *arcCount, int from, int to, double constant, double multiplier)
+/*************************************************************************
+setArc
+*************************************************************************/
+{
+	arcMatrix[*arcCount * 4 + 0] = (double) from;
+	arcMatrix[*arcCount * 4 + 1] = (double) to;
+	arcMatrix[*arcCount * 4 + 2] = constant;
+	arcMatrix[*arcCount * 4 + 3] = multiplier;
+	++ *arcCount;
+}
+
+static double * createGrid(int side, int *numNodes, int *numArcs, int *source, int *sink)
+/*************************************************************************
+createGrid - Creates the arc matrix of the grid instance
+*************************************************************************/
+{
+	int row, column, pixel;
+	int numBlocks = (side + BLOCK - 1) / BLOCK;
+	int arcCount = 0;
+	double *arcMatrix;
+	int *level;
+
+	*numNodes = side * side + 2;
+	*source = side * side;
+	*sink = side * side + 1;
+	*numArcs = 2 * side * side + 4 * side * (side - 1);
+
+	if ((arcMatrix = (double *)malloc(*numArcs * 4 * sizeof(double))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+	if ((level = (int *)malloc(numBlocks * numBlocks * sizeof(int))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+
+	for (pixel = 0; pixel < numBlocks * numBlocks; ++pixel)
+	{
+		level[pixel] = (int) (LEVELS * nextRandom());
+	}
+
+	for (row = 0; row < side; ++row)
+	{
+		for (column = 0; column < side; ++column)
+		{
+			pixel = row * side + column;
+
+			setArc(arcMatrix, &arcCount, *source, pixel, level[(row / BLOCK) * numBlocks + column / BLOCK], 1.0);
+			setArc(arcMatrix, &arcCount, pixel, *sink, LEVELS, 0.0);
+
+			if (column + 1 < side)
+			{
+				setArc(arcMatrix, &arcCount, pixel, pixel + 1, 1.0, 0.0);
+				setArc(arcMatrix, &arcCount, pixel + 1, pixel, 1.0, 0.0);
+			}
+			if (row + 1 < side)
+			{
+				setArc(arcMatrix, &arcCount, pixel, pixel + side, 1.0, 0.0);
+				setArc(arcMatrix, &arcCount, pixel + side, pixel, 1.0, 0.0);
+			}
+		}
+	}
+
+	free(level);
+
+	return arcMatrix;
+}
+
+int main(int argc, char ** argv)
+{
+	int side, repeats = 1, regionThreads = 1;
+	int numNodes, numArcs, source, sink;
+	int numBreakpoints;
+	int *cuts;
+	double *breakpoints;
+	int stats[5];
+	double times[3];
+	double lambdaRange[2] = {0.0, LEVELS};
+	double *arcMatrix;
+	double start, elapsed, total = 0;
+	hpf_context *ctx;
+	int i;
+
+	if (argc < 2 || argc > 4)
+	{
+		printf("Usage: grid <side> [<repeats> [<region threads>]]\n");
+		exit(0);
+	}
+
+	side = atoi(argv[1]);
+	if (argc >= 3)
+	{
+		repeats = atoi(argv[2]);
+	}
+	if (argc == 4)
+	{
+		regionThreads = atoi(argv[3]);
+	}
+	if (side < 2 || repeats < 1 || regionThreads < 1)
+	{
+		printf("The side should be at least 2, repeats and region threads at least 1\n");
+		exit(0);
+	}
+
+	arcMatrix = createGrid(side, &numNodes, &numArcs, &source, &sink);
+	printf("c grid %d x %d: %d nodes, %d arcs\n", side, side, numNodes, numArcs);
+
+	ctx = hpf_context_create();
+	hpf_context_set_option(ctx, HPF_OPTION_REGION_THREADS, regionThreads);
+	for (i = 0; i < repeats; ++i)
+	{
+		start = wallTime();
+		hpf_context_solve(ctx, numNodes, numArcs, source, sink, arcMatrix, lambdaRange, 0, &numBreakpoints, &cuts, &breakpoints, stats, times);
+		elapsed = wallTime() - start;
+		total += elapsed;
+		printf("r %d %.3lf\n", i, elapsed);
+
+		libfree(cuts);
+		libfree(breakpoints);
+	}
+	hpf_context_destroy(ctx);
+
+	printf("p %d\n", numBreakpoints);
+	printf("s %d %d %d %d %d\n", stats[0], stats[1], stats[2], stats[3], stats[4]);
+	printf("t %.3lf\n", total / repeats);
+
+	free(arcMatrix);
+
+	return 0;
+}
@@ -0,0 +1,151 @@
+/*************************************************************************
+ * Region thread check for the HPF parametric minimum cut solver         *
+ * ***********************************************************************
+ * Solves random sparse graphs of 10 to <max nodes> nodes once with one  *
+ * region thread and once with <region threads> of them, and fails if    *
+ * the breakpoints or cuts differ. Every node has a source adjacent arc  *
+ * with capacity <random constant> + lambda, a sink adjacent arc with a  *
+ * random constant capacity and DEGREE arcs to random other nodes. The   *
+ * instances are generated with a fixed seed.                            *
+ *                                                                       *
+ * Usage:																 *
+ *	 regions <max nodes> <region threads>								 *
+ *                                                                       *
+ * Subproblems are only split into regions from REGION_MIN_NODES nodes   *
+ * on, so the library has to be built with a small REGION_MIN_NODES for  *
+ * the check to exercise the regions, see make check-regions. A small    *
+ * ARENA_MIN_BLOCK makes the scratch arena of every subproblem start new *
+ * blocks often, also while the region workers are set up.              *
+ *************************************************************************/
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "../core/libhpf.h"
+
+#define DEGREE 3
+#define LAMBDA_HIGH 60.0
+
+static unsigned int seed = 12345;
+
+static double nextRandom(void)
+/*************************************************************************
+nextRandom - Uniform number in [0, 1) from a fixed xorshift sequence
+*************************************************************************/
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return (seed & 0xFFFFFF) / (double) 0x1000000;
+}
+
+static void setArc(double *arcMatrix, int *arcCount, int from, int to, double constant, double multiplier)
+/*************************************************************************
+setArc
+*************************************************************************/
+{
+	arcMatrix[*arcCount * 4 + 0] = (double) from;
+	arcMatrix[*arcCount * 4 + 1] = (double) to;
+	arcMatrix[*arcCount * 4 + 2] = constant;
+	arcMatrix[*arcCount * 4 + 3] = multiplier;
+	++ (*arcCount);
+}
+
+static double * createRandom(int numNodes, int *numArcs)
+/*************************************************************************
+createRandom - Random graph with source 0, sink 1 and numNodes - 2 other
+nodes
+*************************************************************************/
+{
+	double *arcMatrix;
+	int i, j, to;
+
+	if ((arcMatrix = (double *)malloc((size_t) numNodes * (DEGREE + 2) * 4 * sizeof(double))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+
+	*numArcs = 0;
+	for (i = 2; i < numNodes; ++i)
+	{
+		setArc(arcMatrix, numArcs, 0, i, (double) (int) (50 * nextRandom()), 1.0);
+		setArc(arcMatrix, numArcs, i, 1, (double) (int) (50 * nextRandom()), 0.0);
+		for (j = 0; j < DEGREE; ++j)
+		{
+			to = 2 + (int) ((numNodes - 2) * nextRandom());
+			if (to != i)
+			{
+				setArc(arcMatrix, numArcs, i, to, (double) (int) (20 * nextRandom()), 0.0);
+			}
+		}
+	}
+
+	return arcMatrix;
+}
+
+static void solve(int numNodes, int numArcs, double *arcMatrix, int regionThreads, int *numBreakpoints, int **cuts, double **breakpoints)
+/*************************************************************************
+solve - Solves the graph over [0, LAMBDA_HIGH] with regionThreads region
+threads
+*************************************************************************/
+{
+	double lambdaRange[2] = {0.0, LAMBDA_HIGH};
+	int stats[5];
+	double times[3];
+	hpf_context *ctx = hpf_context_create();
+
+	hpf_context_set_option(ctx, HPF_OPTION_REGION_THREADS, regionThreads);
+	hpf_context_solve(ctx, numNodes, numArcs, 0, 1, arcMatrix, lambdaRange, 0, numBreakpoints, cuts, breakpoints, stats, times);
+	hpf_context_destroy(ctx);
+}
+
+int main(int argc, char ** argv)
+{
+	int maxNodes, regionThreads;
+	int numNodes, numArcs;
+	int numBreakpoints[2];
+	int *cuts[2];
+	double *breakpoints[2];
+	double *arcMatrix;
+	int numFailed = 0;
+
+	if (argc != 3)
+	{
+		printf("Usage: regions <max nodes> <region threads>\n");
+		exit(0);
+	}
+
+	maxNodes = atoi(argv[1]);
+	regionThreads = atoi(argv[2]);
+	if (maxNodes < 10 || regionThreads < 2)
+	{
+		printf("The max nodes should be at least 10, region threads at least 2\n");
+		exit(0);
+	}
+
+	for (numNodes = 10; numNodes <= maxNodes; ++numNodes)
+	{
+		arcMatrix = createRandom(numNodes, &numArcs);
+		solve(numNodes, numArcs, arcMatrix, 1, &numBreakpoints[0], &cuts[0], &breakpoints[0]);
+		solve(numNodes, numArcs, arcMatrix, regionThreads, &numBreakpoints[1], &cuts[1], &breakpoints[1]);
+
+		if (numBreakpoints[0] != numBreakpoints[1]
+				|| memcmp(breakpoints[0], breakpoints[1], numBreakpoints[0] * sizeof(double)) != 0
+				|| memcmp(cuts[0], cuts[1], (size_t) numBreakpoints[0] * numNodes * sizeof(int)) != 0)
+		{
+			printf("%d nodes: the cuts with %d region threads differ\n", numNodes, regionThreads);
+			++ numFailed;
+		}
+
+		libfree(cuts[0]);
+		libfree(cuts[1]);
+		libfree(breakpoints[0]);
+		libfree(breakpoints[1]);
+		free(arcMatrix);
+	}
+
+	printf("%d of %d graphs differ\n", numFailed, maxNodes - 9);
+
+	return (numFailed > 0);
+}
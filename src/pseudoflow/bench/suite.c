@@ -0,0 +1,505 @@
+/*************************************************************************
+ * Benchmark suite for the HPF parametric minimum cut solver             *
+ * ***********************************************************************
+ * Generates instances of the graph families below at several scales,   *
+ * solves the parametric cut of each with hpf_solve and reports the      *
+ * results as a JSON array, one object per instance.                     *
+ *                                                                       *
+ * grid2d    - 4-connected side x side grid as in image segmentation,    *
+ *             the instance of grid.c                                    *
+ * grid3d    - 6-connected side x side x side grid as in volume          *
+ *             segmentation                                              *
+ * bipartite - density subgraph problem: every left node has a source    *
+ *             arc with its weight and arcs of infinite capacity to      *
+ *             DEGREE random right nodes, every right node has a sink    *
+ *             arc with capacity RIGHT_COST - lambda                     *
+ * random    - random sparse graph with DEGREE arcs out of every node    *
+ * chain     - long path with arcs in both directions, a one pixel wide  *
+ *             image                                                     *
+ *                                                                       *
+ * Except for bipartite, every node has a source adjacent arc with       *
+ * capacity <level> + lambda and a sink adjacent arc with capacity       *
+ * LEVELS, where the levels are constant on blocks of nodes, so the      *
+ * number of breakpoints stays small. Scale k has about k * BASE_NODES   *
+ * nodes. The instances are generated with a fixed seed and only depend  *
+ * on the family and the scale.                                          *
+ *                                                                       *
+ * Usage:																 *
+ *	 suite [-f <family>] [-r <repeats>] [<scale> ...]					 *
+ * The default is all families at scales 1, 4 and 16, solved once.		 *
+ *                                                                       *
+ * Every instance is generated and solved in a child process, so that   *
+ * peak_rss_kb is the peak resident memory of that instance alone,       *
+ * including its arc matrix. seconds is the mean wall clock time of the  *
+ * repeats and arcs_per_second the number of arcs divided by it. The     *
+ * stats are those of the last repeat.                                   *
+ *************************************************************************/
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../core/libhpf.h"
+
+#define LEVELS 8
+#define BLOCK 32
+#define BASE_NODES 16384
+#define DEGREE 4
+#define RIGHT_COST 16
+#define INFINITE_CAPACITY 1e9
+
+typedef struct Instance
+{
+	const char *family;
+	int numNodes;
+	int numArcs;
+	int source;
+	int sink;
+	double lambdaRange[2];
+	double *arcMatrix;
+} Instance;
+
+static const char *families[] = {"grid2d", "grid3d", "bipartite", "random", "chain"};
+
+#define NUM_FAMILIES ((int) (sizeof families / sizeof families[0]))
+
+static unsigned int seed;
+
+static double nextRandom(void)
+/*************************************************************************
+nextRandom - Uniform number in [0, 1) from a fixed xorshift sequence
+*************************************************************************/
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return (seed & 0xFFFFFF) / (double) 0x1000000;
+}
+
+static int randomNode(int numNodes)
+/*************************************************************************
+randomNode - Uniform node number in [0, numNodes)
+*************************************************************************/
+{
+	return (int) (numNodes * nextRandom());
+}
+
+static double wallTime(void)
+/*************************************************************************
+wallTime - Seconds since an arbitrary point, also with several threads
+*************************************************************************/
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static void allocateInstance(Instance *instance, int numNodes, int maxArcs)
+/*************************************************************************
+allocateInstance - Allocates the arc matrix for up to maxArcs arcs. The
+source and sink are the last two nodes.
+*************************************************************************/
+{
+	instance->numNodes = numNodes;
+	instance->numArcs = 0;
+	instance->source = numNodes - 2;
+	instance->sink = numNodes - 1;
+	instance->lambdaRange[0] = 0.0;
+	instance->lambdaRange[1] = LEVELS;
+
+	if ((instance->arcMatrix = (double *)malloc((size_t) maxArcs * 4 * sizeof(double))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+}
+
+static void addArc(Instance *instance, int from, int to, double constant, double multiplier)
+/*************************************************************************
+addArc
+*************************************************************************/
+{
+	double *arc = instance->arcMatrix + (size_t) instance->numArcs * 4;
+
+	arc[0] = (double) from;
+	arc[1] = (double) to;
+	arc[2] = constant;
+	arc[3] = multiplier;
+	++ instance->numArcs;
+}
+
+static void addTerminalArcs(Instance *instance, int node, int level)
+/*************************************************************************
+addTerminalArcs - Source arc <level> + lambda and sink arc LEVELS of a
+pixel
+*************************************************************************/
+{
+	addArc(instance, instance->source, node, level, 1.0);
+	addArc(instance, node, instance->sink, LEVELS, 0.0);
+}
+
+static void addPair(Instance *instance, int first, int second)
+/*************************************************************************
+addPair - Arcs of capacity 1 in both directions between two neighbours
+*************************************************************************/
+{
+	addArc(instance, first, second, 1.0, 0.0);
+	addArc(instance, second, first, 1.0, 0.0);
+}
+
+static int * createLevels(int numBlocks)
+/*************************************************************************
+createLevels - Random level in [0, LEVELS) for every block
+*************************************************************************/
+{
+	int *level;
+	int i;
+
+	if ((level = (int *)malloc(numBlocks * sizeof(int))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+	for (i = 0; i < numBlocks; ++i)
+	{
+		level[i] = (int) (LEVELS * nextRandom());
+	}
+	return level;
+}
+
+static void createGrid2d(Instance *instance, int scale)
+/*************************************************************************
+createGrid2d - Grid of about scale * BASE_NODES pixels with square blocks
+of BLOCK x BLOCK pixels
+*************************************************************************/
+{
+	int side = 2;
+	int numBlocks, row, column, pixel;
+	int *level;
+
+	while ((side + 1) * (side + 1) <= scale * BASE_NODES)
+	{
+		++side;
+	}
+	numBlocks = (side + BLOCK - 1) / BLOCK;
+	level = createLevels(numBlocks * numBlocks);
+	allocateInstance(instance, side * side + 2, 2 * side * side + 4 * side * (side - 1));
+
+	for (row = 0; row < side; ++row)
+	{
+		for (column = 0; column < side; ++column)
+		{
+			pixel = row * side + column;
+			addTerminalArcs(instance, pixel, level[(row / BLOCK) * numBlocks + column / BLOCK]);
+			if (column + 1 < side)
+			{
+				addPair(instance, pixel, pixel + 1);
+			}
+			if (row + 1 < side)
+			{
+				addPair(instance, pixel, pixel + side);
+			}
+		}
+	}
+
+	free(level);
+}
+
+static void createGrid3d(Instance *instance, int scale)
+/*************************************************************************
+createGrid3d - Grid of about scale * BASE_NODES voxels with cubic blocks
+of BLOCK / 4 voxels on a side
+*************************************************************************/
+{
+	int side = 2;
+	int block = BLOCK / 4;
+	int numBlocks, x, y, z, voxel;
+	int *level;
+
+	while ((side + 1) * (side + 1) * (side + 1) <= scale * BASE_NODES)
+	{
+		++side;
+	}
+	numBlocks = (side + block - 1) / block;
+	level = createLevels(numBlocks * numBlocks * numBlocks);
+	allocateInstance(instance, side * side * side + 2, 2 * side * side * side + 6 * side * side * (side - 1));
+
+	for (z = 0; z < side; ++z)
+	{
+		for (y = 0; y < side; ++y)
+		{
+			for (x = 0; x < side; ++x)
+			{
+				voxel = (z * side + y) * side + x;
+				addTerminalArcs(instance, voxel, level[((z / block) * numBlocks + y / block) * numBlocks + x / block]);
+				if (x + 1 < side)
+				{
+					addPair(instance, voxel, voxel + 1);
+				}
+				if (y + 1 < side)
+				{
+					addPair(instance, voxel, voxel + side);
+				}
+				if (z + 1 < side)
+				{
+					addPair(instance, voxel, voxel + side * side);
+				}
+			}
+		}
+	}
+
+	free(level);
+}
+
+static void createBipartite(Instance *instance, int scale)
+/*************************************************************************
+createBipartite - Density subgraph problem with scale * BASE_NODES / 2
+nodes on each side. The source set at lambda holds the left nodes and
+their neighbours that maximize the left weight minus RIGHT_COST - lambda
+per right node.
+*************************************************************************/
+{
+	int numLeft = scale * BASE_NODES / 2;
+	int numRight = scale * BASE_NODES / 2;
+	int i, j;
+
+	allocateInstance(instance, numLeft + numRight + 2, numLeft * (DEGREE + 1) + numRight);
+	instance->lambdaRange[1] = RIGHT_COST;
+
+	for (i = 0; i < numLeft; ++i)
+	{
+		addArc(instance, instance->source, i, 1 + (int) (LEVELS * nextRandom()), 0.0);
+		for (j = 0; j < DEGREE; ++j)
+		{
+			addArc(instance, i, numLeft + randomNode(numRight), INFINITE_CAPACITY, 0.0);
+		}
+	}
+	for (i = 0; i < numRight; ++i)
+	{
+		addArc(instance, numLeft + i, instance->sink, RIGHT_COST, -1.0);
+	}
+}
+
+static void createRandom(Instance *instance, int scale)
+/*************************************************************************
+createRandom - Random graph of scale * BASE_NODES nodes, each with DEGREE
+arcs to random other nodes, with blocks of BLOCK consecutive nodes
+sharing a level
+*************************************************************************/
+{
+	int numNodes = scale * BASE_NODES;
+	int *level = createLevels((numNodes + BLOCK - 1) / BLOCK);
+	int i, j, to;
+
+	allocateInstance(instance, numNodes + 2, numNodes * (DEGREE + 2));
+
+	for (i = 0; i < numNodes; ++i)
+	{
+		addTerminalArcs(instance, i, level[i / BLOCK]);
+		for (j = 0; j < DEGREE; ++j)
+		{
+			to = randomNode(numNodes - 1);
+			addArc(instance, i, (to >= i) ? to + 1 : to, (double) (1 + (int) (4 * nextRandom())), 0.0);
+		}
+	}
+
+	free(level);
+}
+
+static void createChain(Instance *instance, int scale)
+/*************************************************************************
+createChain - Path of scale * BASE_NODES nodes with blocks of BLOCK
+consecutive nodes sharing a level
+*************************************************************************/
+{
+	int numNodes = scale * BASE_NODES;
+	int *level = createLevels((numNodes + BLOCK - 1) / BLOCK);
+	int i;
+
+	allocateInstance(instance, numNodes + 2, 4 * numNodes);
+
+	for (i = 0; i < numNodes; ++i)
+	{
+		addTerminalArcs(instance, i, level[i / BLOCK]);
+		if (i + 1 < numNodes)
+		{
+			addPair(instance, i, i + 1);
+		}
+	}
+
+	free(level);
+}
+
+static void createInstance(Instance *instance, const char *family, int scale)
+/*************************************************************************
+createInstance - Generates the instance of a family at a scale
+*************************************************************************/
+{
+	seed = 12345;
+	instance->family = family;
+
+	if (strcmp(family, "grid2d") == 0)
+	{
+		createGrid2d(instance, scale);
+	}
+	else if (strcmp(family, "grid3d") == 0)
+	{
+		createGrid3d(instance, scale);
+	}
+	else if (strcmp(family, "bipartite") == 0)
+	{
+		createBipartite(instance, scale);
+	}
+	else if (strcmp(family, "random") == 0)
+	{
+		createRandom(instance, scale);
+	}
+	else
+	{
+		createChain(instance, scale);
+	}
+}
+
+static void runInstance(const char *family, int scale, int repeats)
+/*************************************************************************
+runInstance - Generates and solves an instance and prints its JSON object
+*************************************************************************/
+{
+	Instance instance;
+	int numBreakpoints;
+	int *cuts;
+	double *breakpoints;
+	int stats[5];
+	double times[3];
+	double start, elapsed, total = 0, fastest = 0;
+	struct rusage usage;
+	int i;
+
+	createInstance(&instance, family, scale);
+
+	for (i = 0; i < repeats; ++i)
+	{
+		start = wallTime();
+		hpf_solve(instance.numNodes, instance.numArcs, instance.source, instance.sink, instance.arcMatrix, instance.lambdaRange, 0, &numBreakpoints, &cuts, &breakpoints, stats, times);
+		elapsed = wallTime() - start;
+		total += elapsed;
+		if (i == 0 || elapsed < fastest)
+		{
+			fastest = elapsed;
+		}
+
+		libfree(cuts);
+		libfree(breakpoints);
+	}
+	getrusage(RUSAGE_SELF, &usage);
+
+	printf("  {\"family\": \"%s\", \"scale\": %d, \"nodes\": %d, \"arcs\": %d, \"repeats\": %d, ", family, scale, instance.numNodes, instance.numArcs, repeats);
+	printf("\"seconds\": %.6lf, \"min_seconds\": %.6lf, \"arcs_per_second\": %.0lf, ", total / repeats, fastest, total > 0 ? instance.numArcs * repeats / total : 0.0);
+	printf("\"breakpoints\": %d, \"peak_rss_kb\": %ld, ", numBreakpoints, (long) usage.ru_maxrss);
+	printf("\"stats\": {\"arc_scans\": %d, \"mergers\": %d, \"pushes\": %d, \"relabels\": %d, \"gaps\": %d}, ", stats[0], stats[1], stats[2], stats[3], stats[4]);
+	printf("\"times\": {\"read\": %.6lf, \"initialize\": %.6lf, \"solve\": %.6lf}}", times[0], times[1], times[2]);
+
+	free(instance.arcMatrix);
+}
+
+static int isFamily(const char *name)
+{
+	int i;
+
+	for (i = 0; i < NUM_FAMILIES; ++i)
+	{
+		if (strcmp(name, families[i]) == 0)
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int main(int argc, char ** argv)
+{
+	const char *family = NULL;
+	int repeats = 1;
+	int defaultScales[] = {1, 4, 16};
+	int *scales = defaultScales;
+	int numScales = 3;
+	int numRuns = 0;
+	int argument = 1;
+	int f, k, status;
+	pid_t child;
+
+	while (argument + 1 < argc && argv[argument][0] == '-')
+	{
+		if (strcmp(argv[argument], "-f") == 0 && isFamily(argv[argument + 1]))
+		{
+			family = argv[argument + 1];
+		}
+		else if (strcmp(argv[argument], "-r") == 0 && atoi(argv[argument + 1]) >= 1)
+		{
+			repeats = atoi(argv[argument + 1]);
+		}
+		else
+		{
+			break;
+		}
+		argument += 2;
+	}
+
+	if (argument < argc)
+	{
+		numScales = argc - argument;
+		if ((scales = (int *)malloc(numScales * sizeof(int))) == NULL)
+		{
+			printf("Could not allocate memory.\n");
+			exit(0);
+		}
+		for (k = 0; k < numScales; ++k)
+		{
+			scales[k] = atoi(argv[argument + k]);
+			if (scales[k] < 1 || scales[k] > 8192)
+			{
+				printf("Usage: suite [-f grid2d|grid3d|bipartite|random|chain] [-r <repeats>] [<scale> ...], with scales from 1 to 8192\n");
+				exit(0);
+			}
+		}
+	}
+
+	printf("[\n");
+	for (f = 0; f < NUM_FAMILIES; ++f)
+	{
+		if (family != NULL && strcmp(family, families[f]) != 0)
+		{
+			continue;
+		}
+		for (k = 0; k < numScales; ++k)
+		{
+			printf(numRuns++ > 0 ? ",\n" : "");
+			fflush(stdout);
+
+			/* a child per instance, so that its peak memory is its own */
+			child = fork();
+			if (child == 0)
+			{
+				runInstance(families[f], scales[k], repeats);
+				fflush(stdout);
+				_exit(0);
+			}
+			if (child < 0 || waitpid(child, &status, 0) != child || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+			{
+				printf("  {\"family\": \"%s\", \"scale\": %d, \"error\": \"the solve did not complete\"}", families[f], scales[k]);
+			}
+		}
+	}
+	printf("\n]\n");
+
+	if (scales != defaultScales)
+	{
+		free(scales);
+	}
+
+	return 0;
+}
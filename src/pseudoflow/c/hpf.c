@@ -37,6 +37,20 @@
  * 1. Compile hpf.c with a C-compiler (e.g. gcc)						 *
  * 2. To execute within bash environment:								 *
  *	 <name compiled hpf executable> <path input file> <path output file> *
+ *	 Options before the paths: -v prints the arcs and the cuts, and		 *
+ *	 -j <threads> sets the number of threads that read the arcs			 *
+ *	 (default: the number of processors).								 *
+ * 3. To convert an input file to a binary graph file, which is read	 *
+ *	 without parsing:													 *
+ *	 <name compiled hpf executable> -c <path input file> <path graph> *
+ *	 The graph file is then used in place of the input file.			 *
+ * 4. To split the lambda range over several runs or machines, first	 *
+ *	 solve at every lambda where the range is split, and at both ends,	 *
+ *	 with -b -r <lambda> <lambda>. Then solve every part with			 *
+ *	 -b -r <low> <high> -e <cuts at low> <cuts at high>, which starts	 *
+ *	 from the cuts of the probes instead of solving at the ends, and	 *
+ *	 merge the parts in increasing order of lambda with					 *
+ *	 <name compiled hpf executable> [-b] -m <part> ... <path output file>*
  *                                                                       *
  * INPUT FILE                                                            *
  * **********                                                            *
@@ -69,6 +83,21 @@
  * l <lambda upperbound interval 1> ... <lambda upperbound interval k>   *
  * n <node-id> <sourceset indicator intval 1 > .. <indicator intval k>   *
  *                                                                       *
+ * With -b the output file is binary instead, and the breakpoints are	 *
+ * written while they are found, so the cuts are never kept in memory.	 *
+ * It holds a 64 byte header with "HPFCUTS", the version (1), the number *
+ * of nodes, the number of breakpoints k, the five stats and the three	 *
+ * times as ints and doubles. Then for every interval the lambda upper	 *
+ * bound as a double and the source set as (# nodes + 31) / 32 words of  *
+ * 32 bits, node j being bit j % 32 of word j / 32, padded with a zero	 *
+ * word to a multiple of 8 bytes.										 *
+ *                                                                       *
+ * With -f lambda flowFile a maximum flow at lambda is written to		 *
+ * flowFile as well:													 *
+ * l <lambda>															 *
+ * v <value of the flow, the capacity of a minimum cut at lambda>		 *
+ * a <from-node> <to-node> <flow>, one line per arc in input order		 *
+ *                                                                       *
  * Set-up                                                                *
  * ******                                                                *
  * Uncompress the MatlabHPF.zip file into the Matlab's working directory *
@@ -92,267 +121,1262 @@
  * Pseudoflow/maxflow.html                                               *
  *************************************************************************/
 
-#include "stdio.h"
-#include "stdlib.h"
-#include "../core/libhpf.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+#include "../core/libhpf.h"
+
+#if defined(_MSC_VER) && !defined(HPF_NO_THREADS)
+#define HPF_NO_THREADS
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifndef HPF_NO_THREADS
+#include <pthread.h>
+#endif
+
+/* arc sections are split in chunks of at least this many bytes, one per
+   thread */
+#ifndef PARSE_MIN_BYTES
+#define PARSE_MIN_BYTES (1 << 22)
+#endif
+
+/* longest number that is handed to strtod */
+#define MAX_TOKEN 512
+
+/* size of the buffer in which the n lines of the output are formatted */
+#define OUTPUT_BUFFER_BYTES (1 << 20)
+
+/* binary output file, see OUTPUT FILE */
+#define CUTS_MAGIC "HPFCUTS"
+#define CUTS_VERSION 1
+
+typedef unsigned long long int ullint;
+
+typedef struct InputGraph
+{
+	int numNodes;
+	int numArcs;
+	int source;
+	int sink;
+	double lambdaRange[2];
+	int roundNegativeCapacity;
+	int *from;
+	int *to;
+	double *constant;
+	double *multiplier;
+	/* binary graph file that holds the arrays, or NULL if they are allocated */
+	const char *graphFile;
+	size_t graphFileSize;
+} InputGraph;
+
+typedef struct OutputBuffer
+{
+	FILE *f;
+	const char *filename;
+	char *data;
+	size_t length;
+	size_t capacity;
+} OutputBuffer;
+
+typedef struct CutsHeader
+{
+	char magic[8];
+	int version;
+	int numNodes;
+	int numBreakpoints;
+	int stats[5];
+	double times[3];
+} CutsHeader;
+
+typedef struct CutsFile
+{
+	FILE *f;
+	const char *filename;
+	int numWords;
+	CutsHeader header;
+} CutsFile;
+
+typedef struct ParseChunk
+{
+	const char *begin;
+	const char *end;
+	InputGraph *graph;
+	void (*task)(struct ParseChunk *chunk);
+	int firstArc;
+	int numArcs;
+	int numKept;
+	int hasError;
+	char error[128];
+} ParseChunk;
+
+static const double powersOfTen[] =
+{
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static double wallTime(void)
+/*************************************************************************
+wallTime - Seconds since an arbitrary point
+*************************************************************************/
+{
+#ifndef _WIN32
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+#else
+	return (double) clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static const char * mapFile(char *filename, size_t *size)
+/*************************************************************************
+mapFile - Maps the file in memory, or reads it to memory where mmap is not
+available. The contents are not terminated by a zero.
+*************************************************************************/
+{
+	char *data;
+#ifndef _WIN32
+	struct stat status;
+	int descriptor = open(filename, O_RDONLY);
+
+	if (descriptor < 0)
+	{
+		printf("I/O error while opening input file %s", filename);
+		exit(0);
+	}
+	if (fstat(descriptor, &status) != 0)
+	{
+		printf("I/O error while reading %s\n", filename);
+		exit(0);
+	}
+
+	*size = (size_t) status.st_size;
+	if (*size == 0)
+	{
+		close(descriptor);
+		return NULL;
+	}
+
+	data = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	close(descriptor);
+	if (data == MAP_FAILED)
+	{
+		printf("I/O error while reading %s\n", filename);
+		exit(0);
+	}
+	madvise(data, *size, MADV_SEQUENTIAL);
+#else
+	long length;
+	FILE* f = fopen(filename, "rb");
+
+	if (f == NULL)
+	{
+		printf("I/O error while opening input file %s", filename);
+		exit(0);
+	}
+
+	fseek(f, 0, SEEK_END);
+	length = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	*size = (size_t) length;
+
+	if ((data = (char *)malloc(*size + 1)) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+	if (fread(data, 1, *size, f) != *size)
+	{
+		printf("I/O error while reading %s\n", filename);
+		exit(0);
+	}
+	fclose(f);
+#endif
+
+	return data;
+}
+
+static void unmapFile(const char *data, size_t size)
+/*************************************************************************
+unmapFile
+*************************************************************************/
+{
+	if (data == NULL)
+	{
+		return;
+	}
+#ifndef _WIN32
+	munmap((void *) data, size);
+#else
+	free((void *) data);
+#endif
+}
+
+static const char * nextLine(const char *line, const char *end)
+/*************************************************************************
+nextLine - Start of the line after the one starting at line
+*************************************************************************/
+{
+	const char *newline = memchr(line, '\n', end - line);
+
+	return (newline == NULL) ? end : newline + 1;
+}
+
+static int isBlank(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+static const char * skipBlanks(const char *position, const char *end)
+{
+	while (position < end && isBlank(*position))
+	{
+		++position;
+	}
+	return position;
+}
+
+static int isTokenEnd(const char *position, const char *end)
+{
+	return position == end || isBlank(*position) || *position == '\n';
+}
+
+static int parseInt(const char **position, const char *end, int *value)
+/*************************************************************************
+parseInt - Reads a decimal int after optional blanks. Returns 0 if there
+is no valid int.
+*************************************************************************/
+{
+	const char *p = skipBlanks(*position, end);
+	long long number = 0;
+	int negative = 0;
+	int numDigits = 0;
+
+	if (p < end && (*p == '-' || *p == '+'))
+	{
+		negative = (*p == '-');
+		++p;
+	}
+	for (; p < end && *p >= '0' && *p <= '9'; ++p)
+	{
+		number = number * 10 + (*p - '0');
+		if (number > 2147483648LL)
+		{
+			return 0;
+		}
+		++numDigits;
+	}
+	if (numDigits == 0 || !isTokenEnd(p, end) || number > 2147483647LL + negative)
+	{
+		return 0;
+	}
+
+	*value = (int) (negative ? -number : number);
+	*position = p;
+	return 1;
+}
+
+static int parseDouble(const char **position, const char *end, double *value)
+/*************************************************************************
+parseDouble - Reads a number after optional blanks. Returns 0 if there is
+no valid number.
+Decimal numbers with at most 19 significant digits whose mantissa and
+power of ten are exact doubles are converted with a single correctly
+rounded multiplication or division. All other numbers, including numbers
+with more digits, hexadecimal numbers, inf and nan, are handed to strtod.
+*************************************************************************/
+{
+	const char *p = skipBlanks(*position, end);
+	const char *token = p;
+	char buffer[MAX_TOKEN];
+	char *tokenEnd;
+	ullint mantissa = 0;
+	int numSignificant = 0;
+	int numDigits = 0;
+	int exponent = 0;
+	int exponentPart = 0;
+	int exponentSign = 1;
+	int hasExponent = 0;
+	int exponentDigits = 0;
+	int negative = 0;
+	size_t length;
+
+	if (p < end && (*p == '-' || *p == '+'))
+	{
+		negative = (*p == '-');
+		++p;
+	}
+	for (; p < end && *p >= '0' && *p <= '9'; ++p, ++numDigits)
+	{
+		if (mantissa > 0 || *p != '0')
+		{
+			mantissa = mantissa * 10 + (*p - '0');
+			++numSignificant;
+		}
+	}
+	if (p < end && *p == '.')
+	{
+		for (++p; p < end && *p >= '0' && *p <= '9'; ++p, ++numDigits)
+		{
+			if (mantissa > 0 || *p != '0')
+			{
+				mantissa = mantissa * 10 + (*p - '0');
+				++numSignificant;
+			}
+			--exponent;
+		}
+	}
+	if (numDigits > 0 && p < end && (*p == 'e' || *p == 'E'))
+	{
+		hasExponent = 1;
+		++p;
+		if (p < end && (*p == '-' || *p == '+'))
+		{
+			exponentSign = (*p == '-') ? -1 : 1;
+			++p;
+		}
+		for (; p < end && *p >= '0' && *p <= '9'; ++p, ++exponentDigits)
+		{
+			if (exponentPart < 100000)
+			{
+				exponentPart = exponentPart * 10 + (*p - '0');
+			}
+		}
+		exponent += exponentSign * exponentPart;
+	}
+
+	if (numDigits > 0 && numSignificant <= 19 && isTokenEnd(p, end) && (!hasExponent || exponentDigits > 0))
+	{
+		if (mantissa == 0)
+		{
+			*value = negative ? -0.0 : 0.0;
+			*position = p;
+			return 1;
+		}
+		if (mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22)
+		{
+			*value = (exponent < 0) ? (double) mantissa / powersOfTen[-exponent] : (double) mantissa * powersOfTen[exponent];
+			if (negative)
+			{
+				*value = -*value;
+			}
+			*position = p;
+			return 1;
+		}
+	}
+
+	/* slow path */
+	for (p = token; !isTokenEnd(p, end); ++p)
+		;
+	length = p - token;
+	if (length == 0 || length >= MAX_TOKEN)
+	{
+		return 0;
+	}
+	memcpy(buffer, token, length);
+	buffer[length] = '\0';
+	*value = strtod(buffer, &tokenEnd);
+	if (tokenEnd != buffer + length)
+	{
+		return 0;
+	}
+
+	*position = p;
+	return 1;
+}
+
+static int lineLength(const char *line, const char *end)
+/*************************************************************************
+lineLength - Number of characters of a line that are shown in an error
+*************************************************************************/
+{
+	const char *lineEnd = nextLine(line, end);
+
+	while (lineEnd > line && (lineEnd[-1] == '\n' || lineEnd[-1] == '\r'))
+	{
+		--lineEnd;
+	}
+	return (lineEnd - line > 80) ? 80 : (int) (lineEnd - line);
+}
+
+static void parseError(const char *line, const char *end)
+/*************************************************************************
+parseError - Reports a line that could not be read and exits
+*************************************************************************/
+{
+	printf("Could not read line: %.*s\n", lineLength(line, end), line);
+	exit(0);
+}
+
+static const char * readHeader(const char *data, const char *end, InputGraph *graph)
+/*************************************************************************
+readHeader - Reads the problem and node lines up to the first arc line
+and returns the start of the arc lines
+*************************************************************************/
+{
+	const char *line;
+	const char *p;
+	int isProblemRead = 0;
+	int isSourceAssigned = 0;
+	int isSinkAssigned = 0;
+	int currentNode;
+	char sourceSinkIndicator;
+
+	for (line = data; line < end; line = nextLine(line, end))
+	{
+		p = line + 1;
+		switch (*line)
+		{
+		case 'p': /* initialize problem */
+			if (!parseInt(&p, end, &graph->numNodes) || !parseInt(&p, end, &graph->numArcs)
+					|| !parseDouble(&p, end, &graph->lambdaRange[0]) || !parseDouble(&p, end, &graph->lambdaRange[1])
+					|| !parseInt(&p, end, &graph->roundNegativeCapacity) || graph->numArcs < 0)
+			{
+				parseError(line, end);
+			}
+			isProblemRead = 1;
+			break;
+		case 'n':
+			if (!isProblemRead)
+			{
+				printf("The problem line needs to come before node and arc lines\n");
+				exit(0);
+			}
+			if (!parseInt(&p, end, &currentNode))
+			{
+				parseError(line, end);
+			}
+			p = skipBlanks(p, end);
+			sourceSinkIndicator = (p < end) ? *p : '\n';
+
+			if (sourceSinkIndicator == 's' || sourceSinkIndicator == 't')
+			{
+				/* check if source or sink is valid */
+				if (currentNode >= graph->numNodes || currentNode < 0)
+				{
+					printf("Nodes are labeled from 0 to <number of nodes>  - 1\n");
+					exit(0);
+				}
+			}
+
+			if (sourceSinkIndicator == 's')
+			{
+				/* check if source is assigned */
+				if (isSourceAssigned)
+				{
+					printf("Source is already defined\n");
+					exit(0);
+				}
+				graph->source = currentNode;
+				isSourceAssigned = 1;
+			}
+			else if (sourceSinkIndicator == 't')
+			{
+				/* check if sink is assigned */
+				if (isSinkAssigned)
+				{
+					printf("Sink is already defined\n");
+					exit(0);
+				}
+				graph->sink = currentNode;
+				isSinkAssigned = 1;
+			}
+			else
+			{
+				printf("Node type: %c is unknown\n", sourceSinkIndicator);
+				exit(0);
+			}
+			break;
+		case 'a':
+			if (!isProblemRead)
+			{
+				printf("The problem line needs to come before node and arc lines\n");
+				exit(0);
+			}
+			if (isSinkAssigned == 0 || isSourceAssigned == 0)
+			{
+				printf("Source and sink need to be defined before arcs are defined.\n");
+				exit(0);
+			}
+			return line;
+		}
+	}
+
+	if (!isProblemRead)
+	{
+		printf("The problem line is missing\n");
+		exit(0);
+	}
+	else if (graph->numArcs != 0)
+	{
+		printf("Incorrect number of arcs specified\n");
+		exit(0);
+	}
+	else if (isSourceAssigned == 0)
+	{
+		printf("Source is not assigned\n");
+		exit(0);
+	}
+	else if (isSinkAssigned == 0)
+	{
+		printf("Sink is not assigned\n");
+		exit(0);
+	}
+
+	return end;
+}
+
+static void countArcs(ParseChunk *chunk)
+/*************************************************************************
+countArcs - Counts the arc lines of a chunk
+*************************************************************************/
+{
+	const char *line;
+
+	chunk->numArcs = 0;
+	for (line = chunk->begin; line < chunk->end; line = nextLine(line, chunk->end))
+	{
+		if (*line == 'a')
+		{
+			++chunk->numArcs;
+		}
+	}
+}
+
+static void parseArcs(ParseChunk *chunk)
+/*************************************************************************
+parseArcs - Reads the arcs of a chunk, starting at arc firstArc of the
+graph. Arcs into the source or out of the sink are dropped, so numKept
+arcs are stored. Errors are recorded in the chunk.
+*************************************************************************/
+{
+	InputGraph *graph = chunk->graph;
+	const char *end = chunk->end;
+	const char *line;
+	const char *p;
+	int from;
+	int to;
+	double constantCapacity;
+	double multiplierCapacity;
+	int arc = chunk->firstArc;
+
+	chunk->numKept = 0;
+	for (line = chunk->begin; line < end; line = nextLine(line, end))
+	{
+		if (*line == 'n' || *line == 'p')
+		{
+			snprintf(chunk->error, sizeof chunk->error, "Problem and node lines need to come before arc lines\n");
+			chunk->hasError = 1;
+			return;
+		}
+		else if (*line != 'a')
+		{
+			continue;
+		}
+
+		p = line + 1;
+		if (!parseInt(&p, end, &from) || !parseInt(&p, end, &to)
+				|| !parseDouble(&p, end, &constantCapacity) || !parseDouble(&p, end, &multiplierCapacity))
+		{
+			snprintf(chunk->error, sizeof chunk->error, "Could not read line: %.*s\n", lineLength(line, end), line);
+			chunk->hasError = 1;
+			return;
+		}
+
+		/* assign arc */
+		if (from < 0 || to < 0 || from >= graph->numNodes || to >= graph->numNodes )
+		{
+			snprintf(chunk->error, sizeof chunk->error, "Nodes are labeled from 0 to <number of nodes>  - 1\n");
+		}
+		else if (from == to)
+		{
+			snprintf(chunk->error, sizeof chunk->error, "Node %u has a self loop which is not allowed\n", from);
+		}
+		else if (multiplierCapacity > 0 && from != graph->source)
+		{
+			snprintf(chunk->error, sizeof chunk->error, "Only source adjacent arcs can have a strictly positive capacity multiplier\n");
+		}
+		else if (multiplierCapacity < 0 && to != graph->sink)
+		{
+			snprintf(chunk->error, sizeof chunk->error, "Only sink adjacent arcs can have a strictly negative capacity multiplier\n");
+		}
+		else if (to == graph->source || from == graph->sink)
+		{
+			continue;
+		}
+		else
+		{
+			graph->from[arc] = from;
+			graph->to[arc] = to;
+			graph->constant[arc] = constantCapacity;
+			graph->multiplier[arc] = multiplierCapacity;
+			++arc;
+			continue;
+		}
+
+		chunk->hasError = 1;
+		return;
+	}
+
+	chunk->numKept = arc - chunk->firstArc;
+}
+
+#ifndef HPF_NO_THREADS
+static void * chunkThread(void *argument)
+/*************************************************************************
+chunkThread - Thread entry point that runs the task of a chunk
+*************************************************************************/
+{
+	ParseChunk *chunk = (ParseChunk *) argument;
+
+	chunk->task(chunk);
+	return NULL;
+}
+#endif
+
+static void runChunks(ParseChunk *chunks, int numChunks, void (*task)(ParseChunk *chunk))
+/*************************************************************************
+runChunks - Runs task on every chunk, the first one on the calling thread
+*************************************************************************/
+{
+	int i;
+#ifndef HPF_NO_THREADS
+	pthread_t *threads;
+
+	if ((threads = (pthread_t *)malloc(numChunks * sizeof(pthread_t))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+
+	for (i = 1; i < numChunks; ++i)
+	{
+		chunks[i].task = task;
+		if (pthread_create(&threads[i], NULL, chunkThread, &chunks[i]) != 0)
+		{
+			task(&chunks[i]);
+			chunks[i].task = NULL;
+		}
+	}
+	task(&chunks[0]);
+	for (i = 1; i < numChunks; ++i)
+	{
+		if (chunks[i].task != NULL)
+		{
+			pthread_join(threads[i], NULL);
+		}
+	}
+
+	free(threads);
+#else
+	for (i = 0; i < numChunks; ++i)
+	{
+		task(&chunks[i]);
+	}
+#endif
+}
+
+static void readGraphFile(const char *data, size_t size, InputGraph *graph)
+/*************************************************************************
+readGraphFile - Points the arc arrays of graph to a mapped binary graph
+file, which is released by freeGraph
+*************************************************************************/
+{
+	hpf_graph_header header;
+
+	memcpy(&header, data, sizeof header);
+	if (header.version != HPF_GRAPH_VERSION || header.numArcs < 0
+			|| (size - sizeof header) / (2 * sizeof(int) + 2 * sizeof(double)) < (size_t) header.numArcs)
+	{
+		printf("Graph file has an unsupported version or is truncated\n");
+		exit(0);
+	}
+
+	graph->numNodes = header.numNodes;
+	graph->numArcs = header.numArcs;
+	graph->source = header.source;
+	graph->sink = header.sink;
+	graph->lambdaRange[0] = header.lambdaRange[0];
+	graph->lambdaRange[1] = header.lambdaRange[1];
+	graph->roundNegativeCapacity = header.roundNegativeCapacity;
+	graph->from = (int *) (data + sizeof header);
+	graph->to = graph->from + header.numArcs;
+	graph->constant = (double *) (graph->to + header.numArcs);
+	graph->multiplier = graph->constant + header.numArcs;
+	graph->graphFile = data;
+	graph->graphFileSize = size;
+}
+
+static void freeGraph(InputGraph *graph)
+/*************************************************************************
+freeGraph
+*************************************************************************/
+{
+	if (graph->graphFile != NULL)
+	{
+		unmapFile(graph->graphFile, graph->graphFileSize);
+		return;
+	}
+
+	free(graph->from);
+	free(graph->to);
+	free(graph->constant);
+	free(graph->multiplier);
+}
+
+static size_t readData(char *filename, int numThreads, InputGraph *graph)
+/*************************************************************************
+readData - Reads the input file and returns its size in bytes.
+Binary graph files are mapped and used as they are, see readGraphFile.
+Text files are mapped in memory too. After the problem and node lines have been
+read, the arc lines are split in up to numThreads chunks that start on a
+line. The arcs of every chunk are counted, the arcs are read to the arc
+arrays at the offsets given by the counts, and the arcs that are kept are
+moved together, so the arcs keep the order of the file.
+*************************************************************************/
+{
+	size_t size;
+	const char *data = mapFile(filename, &size);
+	const char *end = data + size;
+	const char *arcLines;
+	ParseChunk *chunks;
+	int numChunks;
+	int totalArcs = 0;
+	int numKept = 0;
+	int i;
+
+	memset(graph, 0, sizeof *graph);
+	if (size >= sizeof(hpf_graph_header) && memcmp(data, HPF_GRAPH_MAGIC, strlen(HPF_GRAPH_MAGIC)) == 0)
+	{
+		readGraphFile(data, size, graph);
+		return size;
+	}
+
+	arcLines = readHeader(data, end, graph);
+
+	if (graph->source == graph->sink)
+	{
+		printf("The source node and sink node need to be distinct\n");
+		exit(0);
+	}
+
+	numChunks = 1 + (int) ((size_t) (end - arcLines) / PARSE_MIN_BYTES);
+	if (numChunks > numThreads)
+	{
+		numChunks = numThreads;
+	}
+
+	if ((chunks = (ParseChunk *)calloc(numChunks, sizeof(ParseChunk))) == NULL ||
+		(graph->from = (int *)malloc(graph->numArcs * sizeof(int) + 1)) == NULL ||
+		(graph->to = (int *)malloc(graph->numArcs * sizeof(int) + 1)) == NULL ||
+		(graph->constant = (double *)malloc(graph->numArcs * sizeof(double) + 1)) == NULL ||
+		(graph->multiplier = (double *)malloc(graph->numArcs * sizeof(double) + 1)) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+
+	for (i = 0; i < numChunks; ++i)
+	{
+		chunks[i].graph = graph;
+		chunks[i].begin = (i == 0) ? arcLines : chunks[i - 1].end;
+		chunks[i].end = arcLines + (size_t) (end - arcLines) * (i + 1) / numChunks;
+		if (chunks[i].end < chunks[i].begin)
+		{
+			chunks[i].end = chunks[i].begin;
+		}
+		else if (chunks[i].end > chunks[i].begin && chunks[i].end < end && chunks[i].end[-1] != '\n')
+		{
+			chunks[i].end = nextLine(chunks[i].end, end);
+		}
+	}
+
+	/* count the arcs of every chunk to find where its arcs are stored */
+	runChunks(chunks, numChunks, countArcs);
+	for (i = 0; i < numChunks; ++i)
+	{
+		chunks[i].firstArc = totalArcs;
+		totalArcs += chunks[i].numArcs;
+	}
+
+	/* check if correct number of arcs has been specified */
+	if (totalArcs != graph->numArcs)
+	{
+		printf("Incorrect number of arcs specified\n");
+		exit(0);
+	}
+
+	runChunks(chunks, numChunks, parseArcs);
+	for (i = 0; i < numChunks; ++i)
+	{
+		if (chunks[i].hasError)
+		{
+			printf("%s", chunks[i].error);
+			exit(0);
+		}
+
+		if (chunks[i].firstArc != numKept)
+		{
+			memmove(graph->from + numKept, graph->from + chunks[i].firstArc, chunks[i].numKept * sizeof(int));
+			memmove(graph->to + numKept, graph->to + chunks[i].firstArc, chunks[i].numKept * sizeof(int));
+			memmove(graph->constant + numKept, graph->constant + chunks[i].firstArc, chunks[i].numKept * sizeof(double));
+			memmove(graph->multiplier + numKept, graph->multiplier + chunks[i].firstArc, chunks[i].numKept * sizeof(double));
+		}
+		numKept += chunks[i].numKept;
+	}
+	graph->numArcs = numKept;
+
+	free(chunks);
+	unmapFile(data, size);
+
+	return size;
+}
+
+static void flushOutput(OutputBuffer *out)
+/*************************************************************************
+flushOutput - Writes the buffered text to the output file
+*************************************************************************/
+{
+	if (fwrite(out->data, 1, out->length, out->f) != out->length)
+	{
+		printf("I/O error while writing %s\n", out->filename);
+		exit(0);
+	}
+	out->length = 0;
+}
+
+static char * formatInt(char *position, int value)
+/*************************************************************************
+formatInt - Writes value in decimal and returns the end of the digits
+*************************************************************************/
+{
+	char digits[12];
+	unsigned int number = (value < 0) ? 0U - (unsigned int) value : (unsigned int) value;
+	int numDigits = 0;
+
+	do
+	{
+		digits[numDigits++] = (char) ('0' + number % 10);
+		number /= 10;
+	} while (number > 0);
+
+	if (value < 0)
+	{
+		*position++ = '-';
+	}
+	while (numDigits > 0)
+	{
+		*position++ = digits[--numDigits];
+	}
+	return position;
+}
+
+static void writeOutput (char *filename, int numBreakpoints, int numNodes, double* breakpoints, unsigned int* cuts, int* stats, double* times)
+{
+/*************************************************************************
+writeOutput - Writes the text output file. cuts holds the source sets
+in the layout of HPF_CUTS_PACKED. The n lines are formatted by hand in a
+large buffer, 32 nodes at a time, so every word of cuts is read once.
+*************************************************************************/
+	int i, j, b;
+	int numWords = HPF_CUT_WORDS(numNodes);
+	size_t rowBytes = 2 * (size_t) numBreakpoints + 16;
+	unsigned int *column;
+	char *p;
+	OutputBuffer out;
+
+	// open outputFile
+	FILE* f = fopen(filename,"w");
+	if (f == NULL)
+	{
+		printf("I/O error while opening output file %s", filename);
+		exit(0);
+	}
+
+	/* print times */
+	fprintf(f, "t %.3lf %.3lf %.3lf\n", times[0], times[1], times[2]);
+	/* print stats */
+	fprintf(f, "s %d %d %d %d %d\n", stats[0], stats[1], stats[2], stats[3], stats[4]);
+
+	fprintf(f, "p %d\n", numBreakpoints);
+
+	/* print lambda values */
+	fprintf(f, "l ");
+	for (i = 0; i < numBreakpoints; i++)
+	{
+		fprintf(f, "%.12lf", breakpoints[i]);
+		if (i < numBreakpoints - 1)
+		{
+			fprintf(f, " ");
+		}
+		else
+		{
+			fprintf(f, "\n");
+		}
+	}
+
+	out.f = f;
+	out.filename = filename;
+	out.length = 0;
+	out.capacity = (rowBytes > OUTPUT_BUFFER_BYTES) ? rowBytes : OUTPUT_BUFFER_BYTES;
+	if ((out.data = (char *)malloc(out.capacity)) == NULL ||
+		(column = (unsigned int *)malloc(numBreakpoints * sizeof(unsigned int) + 1)) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+
+	/* print values nodes*/
+	for (i = 0; i < numWords; i++)
+	{
+		for (j = 0; j < numBreakpoints; j++)
+		{
+			column[j] = cuts[j * numWords + i];
+		}
+
+		for (b = 0; b < 32 && i * 32 + b < numNodes; b++)
+		{
+			if (out.capacity - out.length < rowBytes)
+			{
+				flushOutput(&out);
+			}
+
+			p = out.data + out.length;
+			*p++ = 'n';
+			*p++ = ' ';
+			p = formatInt(p, i * 32 + b);
+			*p++ = ' ';
+			for (j = 0; j < numBreakpoints; j++)
+			{
+				*p++ = (char) ('0' + ((column[j] >> b) & 1));
+				*p++ = (j < numBreakpoints - 1) ? ' ' : '\n';
+			}
+			out.length = p - out.data;
+		}
+	}
+	flushOutput(&out);
+
+	free(column);
+	free(out.data);
+
+	// close output file
+	if (fclose(f) != 0)
+	{
+		printf("I/O error while writing %s\n", filename);
+		exit(0);
+	}
+}
 
-static void readData(char *filename, int* numNodes, int* numArcs, int *source, int *sink, double ** arcMatrixPointer, double lambdaRange[2], int * roundNegativeCapacity)
+static void openCutsFile(char *filename, int numNodes, CutsFile *cutsFile)
 /*************************************************************************
-readData
+openCutsFile - Creates a binary output file. The header is completed by
+closeCutsFile once the solve has finished.
 *************************************************************************/
 {
-	char buffer[32768];
-
-	/* define parameters */
-	int arcCount = 0;
-	int numRemovedArcs = 0;
-	int currentNode;
-	int isSourceAssigned = 0;
-	int isSinkAssigned = 0;
-	char sourceSinkIndicator;
-	int from;
-	int to;
-	double constantCapacity;
-	double multiplierCapacity;
-	double * arcMatrix;
-	double * arcMatrixNew;
-
-	int i;
+	memset(cutsFile, 0, sizeof *cutsFile);
+	cutsFile->filename = filename;
+	cutsFile->numWords = HPF_CUT_WORDS(numNodes);
+	memcpy(cutsFile->header.magic, CUTS_MAGIC, sizeof cutsFile->header.magic);
+	cutsFile->header.version = CUTS_VERSION;
+	cutsFile->header.numNodes = numNodes;
 
-	// open input file
-	FILE* f = fopen(filename, "r");
-	if (f == NULL)
+	cutsFile->f = fopen(filename, "wb");
+	if (cutsFile->f == NULL)
 	{
-		printf("I/O error while opening input file %s", filename);
+		printf("I/O error while opening output file %s", filename);
 		exit(0);
 	}
-
-	/* Read lines of input file */
-	while (1)
+	if (fwrite(&cutsFile->header, sizeof cutsFile->header, 1, cutsFile->f) != 1)
 	{
-		if (fgets(buffer, sizeof buffer, f) != NULL)
-		{
-			switch (*buffer)
-			{
-			case 'p': /* initialize problem */
-				sscanf(buffer, "p %d %d %lf %lf %d\n", numNodes, numArcs, &lambdaRange[0], &lambdaRange[1], roundNegativeCapacity);
+		printf("I/O error while writing %s\n", filename);
+		exit(0);
+	}
+}
 
-				if ((arcMatrix = (double *)malloc(*numArcs * 4 * sizeof(double))) == NULL)
-				{
-					printf("Could not allocate memory.\n");
-					exit(0);
-				}
+static int writeBreakpoint(void *userData, int index, double lambda, const unsigned int *sourceSet, int numAdded, const int *addedNodes)
+/*************************************************************************
+writeBreakpoint - Breakpoint callback that appends a breakpoint to a
+binary output file
+*************************************************************************/
+{
+	CutsFile *cutsFile = (CutsFile *) userData;
+	unsigned int padding = 0;
 
-				break;
-			case 'n':
-				sscanf(buffer, "n %i %c\n", &currentNode, &sourceSinkIndicator);
-				if (sourceSinkIndicator == 's')
-				{
-					/* check if source is valid */
-					if (currentNode >= *numNodes || currentNode < 0)
-					{
-						printf("Nodes are labeled from 0 to <number of nodes>  - 1\n");
-						exit(0);
-					}
-					/* check if source is assigned */
-					if (isSourceAssigned)
-					{
-						printf("Source is already defined\n");
-						exit(0);
-					}
-					else
-					{
-						*source = currentNode;
-						isSourceAssigned = 1;
-					}
-				}
-				else if (sourceSinkIndicator == 't')
-				{
-					/* check if sink is valid */
-					if (currentNode >= *numNodes || currentNode < 0)
-					{
-						printf("Nodes are labeled from 0 to <number of nodes>  - 1\n");
-						exit(0);
-					}
-					/* check if sink is assigned */
-					if (isSinkAssigned)
-					{
-						printf("Sink is already defined\n");
-						exit(0);
-					}
-					else
-					{
-						*sink = currentNode;
-						isSinkAssigned = 1;
-					}
-				}
-				else
-				{
-					printf("Node type: %c is unknown\n", sourceSinkIndicator);
-					exit(0);
-				}
+	if (fwrite(&lambda, sizeof lambda, 1, cutsFile->f) != 1
+			|| fwrite(sourceSet, sizeof(unsigned int), cutsFile->numWords, cutsFile->f) != (size_t) cutsFile->numWords
+			|| (cutsFile->numWords % 2 == 1 && fwrite(&padding, sizeof padding, 1, cutsFile->f) != 1))
+	{
+		printf("I/O error while writing %s\n", cutsFile->filename);
+		exit(0);
+	}
+	cutsFile->header.numBreakpoints = index + 1;
+	return 0;
+}
 
-				break;
-			case 'a':
-				sscanf(buffer, "a %d %d %lf %lf\n", &from, &to, &constantCapacity, &multiplierCapacity);
+static void closeCutsFile(CutsFile *cutsFile, int* stats, double* times)
+/*************************************************************************
+closeCutsFile - Writes the final header of a binary output file
+*************************************************************************/
+{
+	int i;
 
-				if (isSinkAssigned == 0 || isSourceAssigned == 0)
-				{
-					printf("Source and sink need to be defined before arcs are defined.\n");
-					exit(0);
-				}
+	for (i = 0; i < 5; i++)
+	{
+		cutsFile->header.stats[i] = stats[i];
+	}
+	for (i = 0; i < 3; i++)
+	{
+		cutsFile->header.times[i] = times[i];
+	}
 
-				/* assign arc */
-				if (from < 0 || to < 0 || from >= *numNodes || to >= *numNodes )
-				{
-					printf("Nodes are labeled from 0 to <number of nodes>  - 1\n");
-					exit(0);
-				}
-				else if (from == to)
-				{
-					printf("Node %u has a self loop which is not allowed\n", from);
-					exit(0);
-				}
-				else if (multiplierCapacity > 0 && from != *source)
-				{
-					printf("Only source adjacent arcs can have a strictly positive capacity multiplier\n");
-					exit(0);
-				}
-				else if (multiplierCapacity < 0 && to != *sink)
-				{
-					printf("Only sink adjacent arcs can have a strictly negative capacity multiplier\n");
-					exit(0);
-				}
-				else if (arcCount >= *numArcs)
-				{
-					printf("Incorrect number of arcs specified\n");
-					exit(0);
-				}
-				else if (to==*source || from==*sink)
-				{
-				  numRemovedArcs++;
-				  continue;
-				}
+	if (fseek(cutsFile->f, 0, SEEK_SET) != 0
+			|| fwrite(&cutsFile->header, sizeof cutsFile->header, 1, cutsFile->f) != 1
+			|| fclose(cutsFile->f) != 0)
+	{
+		printf("I/O error while writing %s\n", cutsFile->filename);
+		exit(0);
+	}
+}
+
+static void writeFlows(char *filename, double lambda, const InputGraph *graph, const double *flows)
+/*************************************************************************
+writeFlows - Writes the maximum flow at lambda recovered by the solver,
+see OUTPUT FILE
+*************************************************************************/
+{
+	int i;
+	double value = 0;
+	FILE *f = fopen(filename, "w");
 
-				arcMatrix[ arcCount * 4 + 0] = (double) from;
-				arcMatrix[ arcCount * 4 + 1] = (double) to;
-				arcMatrix[ arcCount * 4 + 2] = constantCapacity;
-				arcMatrix[ arcCount * 4 + 3] = multiplierCapacity;
+	if (f == NULL)
+	{
+		printf("I/O error while opening flow file %s", filename);
+		exit(0);
+	}
 
-				++arcCount;
-			}
-		}
-		else if (feof(f))
+	for (i = 0; i < graph->numArcs; i++)
+	{
+		if (graph->from[i] == graph->source)
 		{
-			break;
+			value += flows[i];
 		}
-		else
+		else if (graph->to[i] == graph->source)
 		{
-			printf("I/O error while reading %s\n", filename);
-			exit(0);
+			value -= flows[i];
 		}
 	}
 
-	// close file
-	fclose(f);
-
-	if (numRemovedArcs>0)
-	{
-	  *numArcs-= numRemovedArcs;
-	  if ((arcMatrixNew = (double *)malloc(*numArcs * sizeof(double))) == NULL)
-	    {
-	      printf("Could not allocate memory.\n");
-	      exit(0);
-	    }
-	  for(i = 0;i < *numArcs * 4;++i)
-		{
-	   	arcMatrixNew[i] = arcMatrix[i];
-	  }
-	  free(arcMatrix);
-	  arcMatrix = arcMatrixNew;
-	}
-	/* check if correct number of arcs has been specified */
-	if (arcCount != *numArcs)
+	fprintf(f, "l %.12lf\n", lambda);
+	fprintf(f, "v %.12lf\n", value);
+	for (i = 0; i < graph->numArcs; i++)
 	{
-		printf("Incorrect number of arcs specified\n");
-		exit(0);
+		fprintf(f, "a %d %d %.12lf\n", graph->from[i], graph->to[i], flows[i]);
 	}
-	else if (isSourceAssigned == 0)
+
+	if (fclose(f) != 0)
 	{
-		printf("Source is not assigned\n");
+		printf("I/O error while writing flow file %s", filename);
 		exit(0);
 	}
-	else if (isSinkAssigned == 0)
+}
+
+static const char * readCutsFile(char *filename, CutsHeader *header, size_t *size)
+/*************************************************************************
+readCutsFile - Maps a binary output file and checks its header. The
+records start sizeof(CutsHeader) bytes into the returned data, which is
+released with unmapFile.
+*************************************************************************/
+{
+	const char *data = mapFile(filename, size);
+	size_t recordBytes;
+
+	if (*size < sizeof *header || memcmp(data, CUTS_MAGIC, sizeof header->magic) != 0)
 	{
-		printf("Sink is not assigned\n");
+		printf("%s is not a binary output file\n", filename);
 		exit(0);
 	}
-	else if (*source == *sink)
+	memcpy(header, data, sizeof *header);
+	recordBytes = sizeof(double) + ((HPF_CUT_WORDS(header->numNodes) + 1) / 2) * 2 * sizeof(unsigned int);
+	if (header->version != CUTS_VERSION || header->numNodes < 0 || header->numBreakpoints < 0
+			|| (*size - sizeof *header) / recordBytes < (size_t) header->numBreakpoints)
 	{
-		printf("The source node and sink node need to be distinct\n");
+		printf("Binary output file %s has an unsupported version or is truncated\n", filename);
 		exit(0);
 	}
-
-	*arcMatrixPointer = arcMatrix;
+	return data;
 }
 
-static void writeOutput (char *filename, int numBreakpoints, int numNodes, double* breakpoints, int* cuts, int* stats, double* times)
+static const char * cutsRecord(const char *data, const CutsHeader *header, int index, double *lambda)
+/*************************************************************************
+cutsRecord - Lambda and source set of breakpoint index of a mapped binary
+output file
+*************************************************************************/
 {
+	int numWords = HPF_CUT_WORDS(header->numNodes);
+	const char *record = data + sizeof *header + (size_t) index * (sizeof(double) + ((numWords + 1) / 2) * 2 * sizeof(unsigned int));
+
+	memcpy(lambda, record, sizeof *lambda);
+	return record + sizeof(double);
+}
+
+static unsigned int * readRangeCut(char *filename, int numNodes)
 /*************************************************************************
-writeOutput
+readRangeCut - Source set of the last breakpoint of a binary output file,
+which for a solve at a single lambda is its minimum cut
 *************************************************************************/
-	int i, j;
+{
+	CutsHeader header;
+	size_t size;
+	const char *data = readCutsFile(filename, &header, &size);
+	int numWords = HPF_CUT_WORDS(numNodes);
+	unsigned int *sourceSet;
+	double lambda;
 
-	// open outputFile
-	FILE* f = fopen(filename,"w");
-	if (f == NULL)
+	if (header.numNodes != numNodes || header.numBreakpoints == 0)
 	{
-		printf("I/O error while opening output file %s", filename);
+		printf("%s does not hold a cut of the %d nodes of the graph\n", filename, numNodes);
 		exit(0);
 	}
+	if ((sourceSet = (unsigned int *)malloc(numWords * sizeof(unsigned int) + 1)) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+	memcpy(sourceSet, cutsRecord(data, &header, header.numBreakpoints - 1, &lambda), numWords * sizeof(unsigned int));
+	unmapFile(data, size);
+	return sourceSet;
+}
 
-	/* print times */
-	fprintf(f, "t %.3lf %.3lf %.3lf\n", times[0], times[1], times[2]);
-	/* print stats */
-	fprintf(f, "s %d %d %d %d %d\n", stats[0], stats[1], stats[2], stats[3], stats[4]);
-
-	fprintf(f, "p %d\n", numBreakpoints);
+static void mergeCutsFiles(char **parts, int numParts, char *filename, int binaryOutput)
+/*************************************************************************
+mergeCutsFiles - Combines the binary output files of solves over
+consecutive parts of a lambda range, given in increasing order of lambda,
+into the output of the whole range. The breakpoints are concatenated and a
+breakpoint is dropped if its source set equals that of the next one, which
+removes the ends of the parts that are not breakpoints of the whole range.
+The stats and times are summed.
+*************************************************************************/
+{
+	CutsHeader header;
+	size_t size;
+	const char *data;
+	const char *sourceSet;
+	int numNodes = -1;
+	int numWords = 0;
+	int numBreakpoints = 0;
+	int capacity = 0;
+	int stats[5] = {0, 0, 0, 0, 0};
+	double times[3] = {0.0, 0.0, 0.0};
+	double *breakpoints = NULL;
+	unsigned int *cuts = NULL;
+	double lambda;
+	CutsFile cutsFile;
+	int p, i;
 
-	/* print lambda values */
-	fprintf(f, "l ");
-	for (i = 0; i < numBreakpoints; i++)
+	for (p = 0; p < numParts; p++)
 	{
-		fprintf(f, "%.12lf", breakpoints[i]);
-		if (i < numBreakpoints - 1)
+		data = readCutsFile(parts[p], &header, &size);
+		if (numNodes < 0)
 		{
-			fprintf(f, " ");
+			numNodes = header.numNodes;
+			numWords = HPF_CUT_WORDS(numNodes);
 		}
-		else
+		else if (header.numNodes != numNodes)
 		{
-			fprintf(f, "\n");
+			printf("%s has %d nodes, but %s has %d\n", parts[p], header.numNodes, parts[0], numNodes);
+			exit(0);
 		}
-	}
 
-	/* print values nodes*/
-	for (i = 0; i < numNodes; i++)
-	{
-		fprintf(f, "n %d ",i);
-		for (j = 0; j < numBreakpoints; j++)
+		if (numBreakpoints + header.numBreakpoints > capacity)
 		{
-			fprintf(f, "%d", cuts[i + j * numNodes]);
-			if (j < numBreakpoints - 1)
+			capacity = 2 * capacity + header.numBreakpoints;
+			if ((breakpoints = (double *)realloc(breakpoints, capacity * sizeof(double))) == NULL ||
+				(cuts = (unsigned int *)realloc(cuts, (size_t) capacity * numWords * sizeof(unsigned int) + 1)) == NULL)
 			{
-				fprintf(f, " ");
+				printf("Could not allocate memory.\n");
+				exit(0);
 			}
-			else
+		}
+
+		for (i = 0; i < header.numBreakpoints; i++)
+		{
+			sourceSet = cutsRecord(data, &header, i, &lambda);
+			if (numBreakpoints > 0 && memcmp(cuts + (size_t) (numBreakpoints - 1) * numWords, sourceSet, numWords * sizeof(unsigned int)) == 0)
+			{
+				--numBreakpoints;
+			}
+			else if (numBreakpoints > 0 && lambda < breakpoints[numBreakpoints - 1])
 			{
-				fprintf(f, "\n");
+				printf("The parts need to be given in increasing order of lambda, %s is not\n", parts[p]);
+				exit(0);
 			}
+			breakpoints[numBreakpoints] = lambda;
+			memcpy(cuts + (size_t) numBreakpoints * numWords, sourceSet, numWords * sizeof(unsigned int));
+			++numBreakpoints;
+		}
+
+		for (i = 0; i < 5; i++)
+		{
+			stats[i] += header.stats[i];
+		}
+		for (i = 0; i < 3; i++)
+		{
+			times[i] += header.times[i];
 		}
+		unmapFile(data, size);
 	}
 
-	// close output file
-	fclose(f);
+	if (binaryOutput)
+	{
+		openCutsFile(filename, numNodes, &cutsFile);
+		for (i = 0; i < numBreakpoints; i++)
+		{
+			writeBreakpoint(&cutsFile, i, breakpoints[i], cuts + (size_t) i * numWords, 0, NULL);
+		}
+		closeCutsFile(&cutsFile, stats, times);
+	}
+	else
+	{
+		writeOutput(filename, numBreakpoints, numNodes, breakpoints, cuts, stats, times);
+	}
+	printf("Merged %d parts: %d breakpoints\n", numParts, numBreakpoints);
+
+	free(breakpoints);
+	free(cuts);
+}
+
+
+static void printProfile(hpf_context *ctx)
+/*************************************************************************
+printProfile - Print the time of each phase of the subproblems and the
+number of subproblems solved at each level of the recursion
+*************************************************************************/
+{
+	static const char *phases[] = {"Contract", "Initialize", "Phase 1", "Cut"};
+	unsigned long long numProblems, numNodes, numArcs;
+	int level, numLevels = (int) hpf_context_get_stat(ctx, HPF_STAT_NUM_LEVELS);
+	int phase;
+
+	printf("Subproblems: %llu\n", hpf_context_get_stat(ctx, HPF_STAT_NUM_SUBPROBLEMS));
+	for (phase = HPF_PHASE_CONTRACT; phase <= HPF_PHASE_CUT; phase++)
+	{
+		printf("%s time: %lf\n", phases[phase], hpf_context_get_phase_time(ctx, (hpf_phase) phase));
+	}
+	for (level = 0; level < numLevels; level++)
+	{
+		hpf_context_get_level(ctx, level, &numProblems, &numNodes, &numArcs);
+		printf("Level %d: %llu subproblems, %llu nodes, %llu arcs\n", level, numProblems, numNodes, numArcs);
+	}
 }
 
 
@@ -361,32 +1385,129 @@ int main(int argc, char **argv)
 main - Main function
 *************************************************************************/
 {
+	int verbose = 0;
+	int convert = 0;
+	int binaryOutput = 0;
+	int merge = 0;
+	int numThreads = 1;
+	int argument = 1;
+	char *lambdaRangeArguments[2] = {NULL, NULL};
+	char *rangeCutsFiles[2] = {NULL, NULL};
+	char *flowFile = NULL;
+	double flowLambda = 0;
+
+#ifndef _WIN32
+	numThreads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+	if (numThreads < 1)
+	{
+		numThreads = 1;
+	}
+#endif
+
+	// read options
+	while (argument < argc && argv[argument][0] == '-')
+	{
+		if (strcmp(argv[argument], "-v") == 0)
+		{
+			verbose = 1;
+			++argument;
+		}
+		else if (strcmp(argv[argument], "-c") == 0)
+		{
+			convert = 1;
+			++argument;
+		}
+		else if (strcmp(argv[argument], "-b") == 0)
+		{
+			binaryOutput = 1;
+			++argument;
+		}
+		else if (strcmp(argv[argument], "-j") == 0 && argument + 1 < argc && atoi(argv[argument + 1]) >= 1)
+		{
+			numThreads = atoi(argv[argument + 1]);
+			argument += 2;
+		}
+		else if (strcmp(argv[argument], "-r") == 0 && argument + 2 < argc)
+		{
+			lambdaRangeArguments[0] = argv[argument + 1];
+			lambdaRangeArguments[1] = argv[argument + 2];
+			argument += 3;
+		}
+		else if (strcmp(argv[argument], "-e") == 0 && argument + 2 < argc)
+		{
+			rangeCutsFiles[0] = argv[argument + 1];
+			rangeCutsFiles[1] = argv[argument + 2];
+			argument += 3;
+		}
+		else if (strcmp(argv[argument], "-f") == 0 && argument + 2 < argc)
+		{
+			flowLambda = atof(argv[argument + 1]);
+			flowFile = argv[argument + 2];
+			argument += 3;
+		}
+		else if (strcmp(argv[argument], "-m") == 0)
+		{
+			merge = 1;
+			++argument;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	if (merge && argc - argument >= 2)
+	{
+		mergeCutsFiles(argv + argument, argc - argument - 1, argv[argc - 1], binaryOutput);
+		return 1;
+	}
+
 	// check number of input arguments
-	if (argc != 3)
+	if (merge || argc - argument != 2)
 	{
-		printf("Incorrect number of input arguments. Call hpf.exe inputFile outputFile\n");
+		printf("Incorrect number of input arguments. Call hpf.exe [-v] [-b] [-j threads] [-r low high] [-e lowCuts highCuts] [-f lambda flowFile] inputFile outputFile, hpf.exe -c inputFile graphFile to convert a text file to a binary graph file, or hpf.exe [-b] -m partFile ... outputFile to merge binary output files of parts of a lambda range\n");
 		exit(0);
 	}
 
 	// prepare input solver
-	int numNodes;
-	int numArcs;
-	int source;
-	int sink;
-	double* arcMatrix;
-	double lambdaRange[2];
-	int roundNegativeCapacity;
+	InputGraph graph;
+	double readStart = wallTime();
+	size_t fileSize = readData(argv[argument], numThreads, &graph);
+	double readTime = wallTime() - readStart;
+
+	if (lambdaRangeArguments[0] != NULL)
+	{
+		graph.lambdaRange[0] = atof(lambdaRangeArguments[0]);
+		graph.lambdaRange[1] = atof(lambdaRangeArguments[1]);
+	}
 
-	readData(argv[1], &numNodes, &numArcs, &source, &sink, &arcMatrix, lambdaRange, &roundNegativeCapacity);
+	printf("NumNodes: %d\n", graph.numNodes);
+	printf("NumArcs: %d\n", graph.numArcs);
+	printf("Lambda Range: [%lf, %lf]\n", graph.lambdaRange[0], graph.lambdaRange[1]);
+	printf("Round if negative: %d\n", graph.roundNegativeCapacity);
+	if (graph.graphFile != NULL)
+	{
+		printf("Graph file: %.1lf MB, read by the solver\n", fileSize / 1e6);
+	}
+	else
+	{
+		printf("Read: %.1lf MB in %.3lf s (%.1lf MB/s)\n", fileSize / 1e6, readTime, readTime > 0 ? fileSize / 1e6 / readTime : 0.0);
+	}
+	if (verbose)
+	{
+		printf("Arc matrix:\n");
+		for (int i = 0; i < graph.numArcs; ++i)
+		{
+			printf("Row %d: [%.2lf, %.2lf, %.2lf, %.2lf]\n", i, (double) graph.from[i], (double) graph.to[i], graph.constant[i], graph.multiplier[i]);
+		}
+	}
 
-	printf("NumNodes: %d\n", numNodes);
-	printf("NumArcs: %d\n", numArcs);
-	printf("Lambda Range: [%lf, %lf]\n", lambdaRange[0], lambdaRange[1]);
-	printf("Round if negative: %d\n", roundNegativeCapacity);
-	printf("Arc matrix:\n");
-	for (int i = 0; i < numArcs; ++i)
+	if (convert)
 	{
-		printf("Row %d: [%.2lf, %.2lf, %.2lf, %.2lf]\n", i, arcMatrix[i * 4 + 0 ], arcMatrix[i * 4 + 1 ], arcMatrix[i * 4 + 2 ], arcMatrix[i * 4 + 3 ]);
+		hpf_write_graph(argv[argument + 1], graph.numNodes, graph.numArcs, graph.source, graph.sink, graph.from, graph.to, graph.constant, graph.multiplier, graph.lambdaRange, graph.roundNegativeCapacity);
+		printf("Wrote graph file %s\n", argv[argument + 1]);
+		freeGraph(&graph);
+		return 1;
 	}
 
 
@@ -396,25 +1517,86 @@ main - Main function
 	double *breakpoints;
 	int stats[5];
 	double times[3];
+	int numWords = HPF_CUT_WORDS(graph.numNodes);
+	CutsFile cutsFile;
+	hpf_context *ctx = hpf_context_create();
+
+	if (binaryOutput)
+	{
+		/* stream the breakpoints to the output file as they are found */
+		openCutsFile(argv[argument + 1], graph.numNodes, &cutsFile);
+		hpf_context_set_callback(ctx, writeBreakpoint, &cutsFile);
+	}
+	else
+	{
+		hpf_context_set_option(ctx, HPF_OPTION_CUT_FORMAT, HPF_CUTS_PACKED);
+	}
+
+	if (verbose)
+	{
+		hpf_context_set_option(ctx, HPF_OPTION_CUT_VALUES, 1);
+	}
+	if (flowFile != NULL)
+	{
+		hpf_context_set_flow_lambda(ctx, &flowLambda);
+	}
+
+	if (rangeCutsFiles[0] != NULL)
+	{
+		/* start from the cuts of probe solves at the ends of the range */
+		unsigned int *lowSourceSet = readRangeCut(rangeCutsFiles[0], graph.numNodes);
+		unsigned int *highSourceSet = readRangeCut(rangeCutsFiles[1], graph.numNodes);
 
-	hpf_solve(numNodes, numArcs, source, sink, arcMatrix, lambdaRange, roundNegativeCapacity, &numBreakpoints, &cuts, &breakpoints, stats, times );
+		hpf_context_set_range_cuts(ctx, graph.numNodes, lowSourceSet, highSourceSet);
+		free(lowSourceSet);
+		free(highSourceSet);
+	}
+
+	if (graph.graphFile != NULL)
+	{
+		hpf_context_solve_file(ctx, argv[argument], graph.lambdaRange, &numBreakpoints, &cuts, &breakpoints, stats, times );
+	}
+	else
+	{
+		hpf_context_solve_arrays(ctx, graph.numNodes, graph.numArcs, graph.source, graph.sink, graph.from, graph.to, graph.constant, graph.multiplier, graph.lambdaRange, graph.roundNegativeCapacity, &numBreakpoints, &cuts, &breakpoints, stats, times );
+	}
+	if (verbose)
+	{
+		printProfile(ctx);
+	}
+	if (flowFile != NULL)
+	{
+		writeFlows(flowFile, flowLambda, &graph, hpf_context_get_flows(ctx));
+	}
+	const double *cutValues = verbose ? hpf_context_get_cut_values(ctx) : NULL;
 
 	printf("Stats: [%d, %d, %d, %d, %d]\n", stats[0],stats[1],stats[2],stats[3],stats[4]);
 	printf("times: [%lf, %lf, %lf]\n", times[0],times[1],times[2]);
 	printf("Num breakpoints: %d\n", numBreakpoints);
-	printf("breakpoints:\n");
-	for (int i = 0; i < numBreakpoints; ++i)
+	if (verbose)
 	{
-		printf("Breakpoint: %lf\n", breakpoints[i]);
-		for (int j = 0; j < numNodes; j++)
+		printf("breakpoints:\n");
+		for (int i = 0; i < numBreakpoints; ++i)
 		{
-			printf("Cut indicator: %d\n", cuts[i * (int) numNodes+ j ]);
+			printf("Breakpoint: %lf, cut capacity: %lf\n", breakpoints[i], cutValues[i]);
+			for (int j = 0; j < graph.numNodes && cuts != NULL; j++)
+			{
+				printf("Cut indicator: %d\n", (int) ((((unsigned int *) cuts)[i * numWords + j / 32] >> (j % 32)) & 1));
+			}
 		}
 	}
+	hpf_context_destroy(ctx);
 
-	writeOutput(argv[2], numBreakpoints, numNodes, breakpoints, cuts, stats, times);
+	if (binaryOutput)
+	{
+		closeCutsFile(&cutsFile, stats, times);
+	}
+	else
+	{
+		writeOutput(argv[argument + 1], numBreakpoints, graph.numNodes, breakpoints, (unsigned int *) cuts, stats, times);
+	}
 
-    free(arcMatrix);
+    freeGraph(&graph);
     free(breakpoints);
     free(cuts);
 
@@ -101,17 +101,51 @@
  *************************************************************************/
 
 #define _CRTDBG_MAP_ALLOC
+/* clock_gettime, mmap and pthreads are POSIX, also under -std=c99 */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
 #include "stdio.h"
 //#include <sys/time.h>
 //#include <sys/resource.h>
 #include "stdlib.h"
+#include "string.h"
 #include "time.h"
+#include "limits.h"
+#include "libhpf.h"
 //#include <unistd.h>
 
+#if defined(_MSC_VER) && !defined(HPF_NO_THREADS)
+#define HPF_NO_THREADS
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifndef HPF_NO_THREADS
+#include <pthread.h>
+#endif
+
 /*************************************************************************
 Definitions
 *************************************************************************/
 #define  MAX_LEVELS  300
+#ifndef PARALLEL_MIN_NODES
+#define  PARALLEL_MIN_NODES  128
+#endif
+#ifndef REGION_MIN_NODES
+#define  REGION_MIN_NODES  100000
+#endif
+#define  ARENA_ALIGN  8
+#define  WORD_BITS  64
+#define  NUM_PHASES  4
+#ifndef ARENA_MIN_BLOCK
+#define  ARENA_MIN_BLOCK  (1 << 20)
+#endif
 #define VERSION 3.3
 
 typedef unsigned int uint;
@@ -119,30 +153,35 @@ typedef long int lint;
 typedef long long int llint;
 typedef unsigned long long int ullint;
 
+/* capacities, flows and excesses. With HPF_INTEGER_CAPACITIES they are
+   64-bit integers, and every problem has to be solved with exact
+   capacities, see setExactLambda. Exact capacities are added without
+   rounding as long as their sum stays below EXACT_CAPACITY_LIMIT. */
+#ifdef HPF_INTEGER_CAPACITIES
+typedef llint Capacity;
+#define  EXACT_CAPACITY_LIMIT  4611686018427387904.0
+#else
+typedef double Capacity;
+#define  EXACT_CAPACITY_LIMIT  9007199254740992.0
+#endif
+
 typedef struct Arc
 	{
-		struct Node *from;
-		struct Node *to;
-		double flow;
-		double capacity;
-		double constant;
-		double multiplier;
+		uint from;
+		uint to;
+		Capacity flow;
+		Capacity capacity;
 		uint direction;
 	} Arc;
 
 typedef struct Node
 	{
-		uint visited;
-		uint numAdjacent;
-		uint number;
-		int originalIndex;
 		uint label;
-		double excess;
+		Capacity excess;
 		struct Node *parent;
 		struct Node *childList;
 		struct Node *nextScan;
 		uint numOutOfTree;
-		Arc **outOfTree;
 		uint nextArc;
 		Arc *arcToParent;
 		struct Node *next;
@@ -156,12 +195,31 @@ typedef struct CutProblem
 	uint numArcs;
 	uint solved;
 	double lambdaValue;
+	/* if lambdaDenominator is positive, lambdaValue is lambdaNumerator /
+	   lambdaDenominator and the capacities are exact, scaled by
+	   lambdaDenominator */
+	llint lambdaNumerator;
+	llint lambdaDenominator;
+	/* source sets whose contraction gives the problem: nodes in the low
+	   set are merged into the source, nodes not in the high set into the
+	   sink. Both are owned by the caller and outlive the problem. */
+	ullint *lowSourceSet;
+	ullint *highSourceSet;
+	/* the contracted graph, only while solveProblem runs */
 	Arc *arcList;
 	Node *nodeList;
+	int *originalIndex;
 	double cutValue;
-	Node *sourceSet;
-	Node *sinkSet;
-    uint *optimalSourceSetIndicator;
+	uint *sourceSet;
+	uint *sinkSet;
+    ullint *optimalSourceSetIndicator;
+	/* final flows of the interior arcs, in order of super arc, unscaled */
+	uint keepInteriorFlows;
+	uint numInteriorArcs;
+	double *interiorArcFlow;
+	/* if not NULL, a maximum flow is recovered once the problem is solved,
+	   and the flow of every super arc is written here, unscaled */
+	double *superArcFlow;
 } CutProblem;
 
 typedef struct Root
@@ -173,10 +231,60 @@ typedef struct Root
 typedef struct Breakpoint
 {
 	double lambdaValue;
-	uint* sourceSetIndicator;
+	ullint* sourceSetIndicator;
 	struct Breakpoint *next;
 } Breakpoint;
 
+typedef struct ArcInput
+{
+	/* either one row [from, to, constant, multiplier] per arc */
+	const double *arcMatrix;
+	/* or separate arrays, with 32 or 64 bit node numbers */
+	const int *from;
+	const int *to;
+	const long long *from64;
+	const long long *to64;
+	const double *constant;
+	const double *multiplier;
+} ArcInput;
+
+typedef struct TaskPool
+{
+#ifndef HPF_NO_THREADS
+	pthread_mutex_t lock;
+#endif
+	uint idleThreads;
+	/* set when the breakpoint callback stops the search */
+	uint isStopped;
+} TaskPool;
+
+typedef struct ArenaBlock
+{
+	struct ArenaBlock *next;
+	size_t size;
+	size_t used;
+} ArenaBlock;
+
+typedef struct Arena
+{
+	ArenaBlock *first;
+	ArenaBlock *current;
+	size_t capacity;
+} Arena;
+
+typedef struct ArenaMark
+{
+	ArenaBlock *block;
+	size_t used;
+} ArenaMark;
+
+typedef struct LevelStats
+{
+	ullint numProblems;
+	ullint numNodes;
+	ullint numArcs;
+} LevelStats;
+
 #ifndef TRUE
 #define TRUE (1)
 #endif
@@ -186,42 +294,139 @@ typedef struct Breakpoint
 #endif
 
 /*************************************************************************
-Global variables
+Solver context
 *************************************************************************/
 // tolerance for denominator == 0
-static double TOL = 1E-8;
-static uint numNodes = 0;
-static uint numArcs = 0;
-static uint numNodesSuper = 0;
-static uint numArcsSuper = 0;
-static uint source;
-static uint sourceSuper;
-static uint sink;
-static uint sinkSuper;
-static uint highestStrongLabel = 1;
-
-static uint numArcScans = 0;
-static uint numPushes = 0;
-static uint numMergers = 0;
-static uint numRelabels = 0;
-static uint numGaps = 0;
-
-static Node *nodesList = NULL;
-static Root *strongRoots = NULL;
-static uint *labelCount = NULL;
-static Arc *arcList = NULL;
-static Node *nodeListSuper = NULL;
-static Arc *arcListSuper = NULL;
-static uint lowestPositiveExcessNode = 0;
-
-static Breakpoint *lastBreakpoint = NULL;
-static Breakpoint *firstBreakpoint = NULL;
-
-static uint useParametricCut = 1;
-static uint roundNegativeCapacity = 0;
-
-static double LAMBDA_LOW;
-static double LAMBDA_HIGH;
+static const double TOL = 1E-8;
+
+struct hpf_context
+{
+	uint numNodes;
+	uint numArcs;
+	uint numNodesSuper;
+	uint numArcsSuper;
+	uint numWordsSuper;
+	uint source;
+	uint sourceSuper;
+	uint sink;
+	uint sinkSuper;
+	uint highestStrongLabel;
+
+	ullint numArcScans;
+	ullint numPushes;
+	ullint numMergers;
+	ullint numRelabels;
+	ullint numGaps;
+	ullint numWarmStarts;
+	ullint numWarmStartArcs;
+	ullint numBucketScans;
+	ullint numGlobalUpdates;
+	ullint numFixedNodes;
+	ullint numRemovedArcs;
+	ullint numSubproblems;
+	ullint numExactSubproblems;
+
+#ifndef HPF_NO_PROFILE
+	/* wall clock time per hpf_phase, and the subproblems of every level of
+	   the recursion, see hpf_context_get_level. recursionLevel is the level
+	   of the subproblems that are solved next. */
+	double phaseTimes[NUM_PHASES];
+	LevelStats *levels;
+	uint numLevels;
+	uint levelCapacity;
+	uint recursionLevel;
+#endif
+
+	Node *nodesList;
+	Root *strongRoots;
+	/* bit l is set if strongRoots[l] is not empty, and bit w of
+	   activeLabelWords if word w of activeLabels is not zero */
+	ullint *activeLabels;
+	ullint *activeLabelWords;
+	uint *labelCount;
+	Arc *arcList;
+	uint *outOfTreeStart;
+	uint *outOfTreeArcs;
+	Arc *arcListSuper;
+	const double *constantSuper;
+	const double *multiplierSuper;
+	uint *adjacentStartSuper;
+	uint *adjacentArcsSuper;
+	/* nodes that reduceGraphSuper fixed in the source or the sink set for
+	   the whole lambda range, or NULL */
+	ullint *fixedSourceSet;
+	ullint *fixedSinkSet;
+	uint lowestPositiveExcessNode;
+
+	Breakpoint *lastBreakpoint;
+	Breakpoint *firstBreakpoint;
+	int numEmittedBreakpoints;
+	unsigned int *packedSourceSet;
+	ullint *emittedSourceSet;
+	int *addedNodes;
+	/* index of the first breakpoint passed to the callback that contains
+	   each node, or -1, kept for the cut values */
+	int *emittedIndices;
+	uint isSearchStopped;
+
+	/* outputs of the last solve that are read after it, or NULL: the cut
+	   value of every breakpoint and the flow of every arc at flowLambda */
+	double *cutValues;
+	double *arcFlows;
+
+	uint useParametricCut;
+	uint roundNegativeCapacity;
+	/* the constants and multipliers of the super graph are integers, with
+	   absolute values that add up to constantSum and multiplierSum.
+	   Problems with exact capacities are only solved if this is set. */
+	uint integralCapacities;
+	double constantSum;
+	double multiplierSum;
+
+	double LAMBDA_LOW;
+	double LAMBDA_HIGH;
+
+	TaskPool *taskPool;
+
+	/* workspace of contractProblem */
+	int *nodeMap;
+	int *sourceAdjacentArcIndices;
+	int *sinkAdjacentArcIndices;
+
+	/* memory of the subproblems, kept across solves. scratch holds graphs
+	   that are only needed while solving, results holds cuts and flows that
+	   are needed by the rest of the recursion. */
+	Arena scratch;
+	Arena results;
+
+	/* final flows of the problems at the ends of the lambda range, kept by
+	   a graph handle so that its next solve starts from them, or NULL */
+	CutProblem *previousLow;
+	CutProblem *previousHigh;
+
+	/* sorted lambdas of hpf_context_solve_lambdas, or NULL */
+	const double *sweepLambdas;
+	uint numSweepLambdas;
+
+	/* source sets at both ends of the lambda range given by
+	   hpf_context_set_range_cuts, two rows of HPF_CUTS_PACKED, or NULL */
+	unsigned int *rangeCuts;
+	int numRangeCutNodes;
+
+	/* settings, kept across solves */
+	uint numThreads;
+	uint numRegionThreads;
+	uint warmStart;
+	uint globalUpdate;
+	uint reduceGraph;
+	uint exactCapacities;
+	uint computeCutValues;
+	uint hasFlowLambda;
+	double flowLambda;
+	uint cutFormat;
+	hpf_breakpoint_callback breakpointCallback;
+	void *callbackData;
+};
 
 double dabs(double value)
 {
@@ -249,7 +454,22 @@ void libfree(void* p)
 	free(p);
 }
 
-int isFlow(double flow)
+static double wallTime(void)
+/*************************************************************************
+wallTime - Seconds since an arbitrary point, also with several threads
+*************************************************************************/
+{
+#ifndef _WIN32
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+#else
+	return (double) clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+int isFlow(Capacity flow)
 /*************************************************************************
 isFlow: We set a threshhold. If the flow value is below the threshhold, we
 take it as no flow. Otherwise we take it as a flow
@@ -260,7 +480,7 @@ take it as no flow. Otherwise we take it as a flow
 	else return 0;
 }
 
-int isExcess(double excess)
+int isExcess(Capacity excess)
 /*************************************************************************
 isExcess: We set a threshhold. If the absolute value of the excess is within
 the threshold, then we take it as nothing. Otherwise we will return the sign
@@ -274,19 +494,181 @@ of the excess (deficit if negative).
 	else return 0;
 }
 
-static void createOutOfTree (Node *nd)
+static uint isIntegral(double value)
+/*************************************************************************
+isIntegral - value is an integer that a double represents exactly
+*************************************************************************/
+{
+	return (dabs(value) < EXACT_CAPACITY_LIMIT && value == (double) (llint) value);
+}
+
+static ArenaBlock * createArenaBlock(size_t size)
+/*************************************************************************
+createArenaBlock - Allocates an empty block with room for size bytes
+*************************************************************************/
 {
+	ArenaBlock *block;
+
+	if ((block = (ArenaBlock *)malloc(sizeof(ArenaBlock) + size)) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+
+	block->next = NULL;
+	block->size = size;
+	block->used = 0;
+
+	return block;
+}
+
+static void * arenaAlloc(Arena *arena, size_t bytes)
 /*************************************************************************
-createOutOfTree
+arenaAlloc - Returns bytes of memory from the arena. Continues in the next
+free block if the current one is full, and appends a new block if none of
+the free blocks is large enough.
 *************************************************************************/
-	if (nd->numAdjacent)
+{
+	ArenaBlock *block = arena->current;
+	ArenaBlock *last = NULL;
+	size_t size;
+	void *memory;
+
+	bytes = (bytes + ARENA_ALIGN - 1) & ~((size_t) ARENA_ALIGN - 1);
+
+	if (block == NULL || block->used + bytes > block->size)
 	{
-		if ((nd->outOfTree = (Arc **) malloc (nd->numAdjacent * sizeof (Arc *))) == NULL)
+		block = (block == NULL) ? arena->first : block->next;
+		while (block != NULL && block->size < bytes)
 		{
-			printf("Out of memory\n");
-			exit(0);
+			last = block;
+			block = block->next;
+		}
+
+		if (block == NULL)
+		{
+			/* grow geometrically */
+			size = (bytes > arena->capacity) ? bytes : arena->capacity;
+			block = createArenaBlock((size > ARENA_MIN_BLOCK) ? size : ARENA_MIN_BLOCK);
+			arena->capacity += block->size;
+
+			if (last == NULL)
+			{
+				for (last = arena->current; last != NULL && last->next != NULL; last = last->next);
+			}
+			if (last == NULL)
+			{
+				arena->first = block;
+			}
+			else
+			{
+				last->next = block;
+			}
 		}
+
+		block->used = 0;
+		arena->current = block;
+	}
+
+	memory = (char *)(block + 1) + block->used;
+	block->used += bytes;
+
+	return memory;
+}
+
+static ArenaMark arenaMark(Arena *arena)
+/*************************************************************************
+arenaMark - Returns the current position of the arena
+*************************************************************************/
+{
+	ArenaMark mark;
+
+	mark.block = arena->current;
+	mark.used = (arena->current != NULL) ? arena->current->used : 0;
+
+	return mark;
+}
+
+static void arenaRewind(Arena *arena, ArenaMark mark)
+/*************************************************************************
+arenaRewind - Releases everything allocated after mark was taken. The
+blocks are kept for later allocations.
+*************************************************************************/
+{
+	arena->current = mark.block;
+	if (mark.block != NULL)
+	{
+		mark.block->used = mark.used;
+	}
+}
+
+static void arenaFree(Arena *arena)
+/*************************************************************************
+arenaFree - Returns all blocks of the arena to the heap
+*************************************************************************/
+{
+	ArenaBlock *block = arena->first;
+	ArenaBlock *next;
+
+	while (block != NULL)
+	{
+		next = block->next;
+		free(block);
+		block = next;
+	}
+
+	arena->first = NULL;
+	arena->current = NULL;
+	arena->capacity = 0;
+}
+
+static void arenaReserve(Arena *arena, size_t bytes)
+/*************************************************************************
+arenaReserve - Empties the arena and makes sure it consists of a single
+block of at least bytes. Blocks that were added during an earlier solve
+are merged, so repeated solves of the same size reuse the same block.
+*************************************************************************/
+{
+	size_t size;
+
+	if (arena->first == NULL || arena->first->next != NULL || arena->first->size < bytes)
+	{
+		size = (bytes > arena->capacity) ? bytes : arena->capacity;
+		arenaFree(arena);
+		arena->first = createArenaBlock(size);
+		arena->capacity = size;
+	}
+
+	arena->current = arena->first;
+	arena->first->used = 0;
+}
+
+static void createOutOfTree (hpf_context *ctx)
+{
+/*************************************************************************
+createOutOfTree - Lays out the out of tree arcs of all nodes in one array.
+The arcs of node i are stored from outOfTreeStart[i] on, and node i never
+has more out of tree arcs than adjacent arcs.
+*************************************************************************/
+	uint i;
+
+	ctx->outOfTreeStart = (uint *) arenaAlloc (&ctx->scratch, (ctx->numNodes + 1) * sizeof (uint));
+
+	for (i=0; i<=ctx->numNodes; ++i)
+	{
+		ctx->outOfTreeStart[i] = 0;
+	}
+	for (i=0; i<ctx->numArcs; ++i)
+	{
+		++ ctx->outOfTreeStart[ctx->arcList[i].from + 1];
+		++ ctx->outOfTreeStart[ctx->arcList[i].to + 1];
+	}
+	for (i=0; i<ctx->numNodes; ++i)
+	{
+		ctx->outOfTreeStart[i+1] += ctx->outOfTreeStart[i];
 	}
+
+	ctx->outOfTreeArcs = (uint *) arenaAlloc (&ctx->scratch, ctx->outOfTreeStart[ctx->numNodes] * sizeof (uint));
 }
 
 static void initializeArc (Arc *ac)
@@ -294,16 +676,14 @@ static void initializeArc (Arc *ac)
 /*************************************************************************
 initializeArc
 *************************************************************************/
-	ac->from = NULL;
-	ac->to = NULL;
+	ac->from = 0;
+	ac->to = 0;
 	ac->capacity = 0.0;
 	ac->flow = 0.0;
 	ac->direction = 1;
-	ac->constant = 0.0;
-	ac->multiplier = 0.0;
 }
 
-static void liftAll (Node *rootNode)
+static void liftAll (hpf_context *ctx, Node *rootNode)
 {
 /*************************************************************************
 liftAll
@@ -312,8 +692,8 @@ liftAll
 
 	current->nextScan = current->childList;
 
-	-- labelCount[current->label];
-	current->label = numNodes;
+	-- ctx->labelCount[current->label];
+	current->label = ctx->numNodes;
 
 	for ( ; (current); current = current->parent)
 	{
@@ -324,35 +704,159 @@ liftAll
 			current = temp;
 			current->nextScan = current->childList;
 
-			-- labelCount[current->label];
-			current->label = numNodes;
+			-- ctx->labelCount[current->label];
+			current->label = ctx->numNodes;
 		}
 	}
 }
-static void addOutOfTreeNode (Node *n, Arc *out)
+static __inline void addOutOfTreeNode (hpf_context *ctx, Node *n, Arc *out)
 {
 /*************************************************************************
 addOutOfTreeNode
 *************************************************************************/
-	n->outOfTree[n->numOutOfTree] = out;
+	ctx->outOfTreeArcs[ctx->outOfTreeStart[n - ctx->nodesList] + n->numOutOfTree] = (uint) (out - ctx->arcList);
 	++ n->numOutOfTree;
 }
 
-static uint sum_array_uint(uint *array, uint num_elements)
+static __inline uint getBit(const ullint *bits, uint i)
 {
-    uint sum = 0;
-    for (uint i = 0; i< num_elements; i++)
-    {
-        sum += array[i];
-    }
-    return sum;
+/*************************************************************************
+getBit - Node i of a source set indicator, stored as a bitset
+*************************************************************************/
+	return (uint) ((bits[i / WORD_BITS] >> (i % WORD_BITS)) & 1);
+}
+
+static __inline void setBit(ullint *bits, uint i)
+{
+/*************************************************************************
+setBit
+*************************************************************************/
+	bits[i / WORD_BITS] |= 1ULL << (i % WORD_BITS);
+}
+
+static __inline uint popcount(ullint word)
+{
+/*************************************************************************
+popcount - Number of bits set in word
+*************************************************************************/
+#if defined(__GNUC__)
+	return (uint) __builtin_popcountll(word);
+#else
+	word = word - ((word >> 1) & 0x5555555555555555ULL);
+	word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+	word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (uint) ((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+static __inline uint findLastSet(ullint word)
+{
+/*************************************************************************
+findLastSet - Index of the highest bit set in a nonzero word
+*************************************************************************/
+#if defined(__GNUC__)
+	return (uint) (WORD_BITS - 1 - __builtin_clzll(word));
+#else
+	uint i = 0;
+
+	while (word >>= 1)
+	{
+		++i;
+	}
+	return i;
+#endif
+}
+
+static __inline void setActiveLabel(hpf_context *ctx, uint label)
+{
+/*************************************************************************
+setActiveLabel - Marks the strong root bucket of label as not empty
+*************************************************************************/
+	setBit(ctx->activeLabels, label);
+	setBit(ctx->activeLabelWords, label / WORD_BITS);
+}
+
+static __inline void clearActiveLabel(hpf_context *ctx, uint label)
+{
+/*************************************************************************
+clearActiveLabel - Marks the strong root bucket of label as empty
+*************************************************************************/
+	uint word = label / WORD_BITS;
+
+	ctx->activeLabels[word] &= ~(1ULL << (label % WORD_BITS));
+	if (ctx->activeLabels[word] == 0)
+	{
+		ctx->activeLabelWords[word / WORD_BITS] &= ~(1ULL << (word % WORD_BITS));
+	}
+}
+
+static uint highestActiveLabel(hpf_context *ctx, uint label)
+{
+/*************************************************************************
+highestActiveLabel - Highest label of at most label whose strong root
+bucket is not empty, or 0 if there is none above bucket 0. The words of
+activeLabels are found through their summary activeLabelWords.
+*************************************************************************/
+	uint word, summary, bit;
+	ullint bits;
+
+	if (label >= ctx->numNodes)
+	{
+		label = ctx->numNodes - 1;
+	}
+
+	word = label / WORD_BITS;
+	bit = label % WORD_BITS;
+	++ ctx->numBucketScans;
+	bits = ctx->activeLabels[word] & ((bit == WORD_BITS - 1) ? ~0ULL : ((1ULL << (bit + 1)) - 1));
+	if (bits != 0)
+	{
+		return word * WORD_BITS + findLastSet(bits);
+	}
+
+	/* the highest nonzero word below word */
+	summary = word / WORD_BITS;
+	bits = ctx->activeLabelWords[summary] & ((1ULL << (word % WORD_BITS)) - 1);
+	while (bits == 0)
+	{
+		if (summary == 0)
+		{
+			return 0;
+		}
+		--summary;
+		++ ctx->numBucketScans;
+		bits = ctx->activeLabelWords[summary];
+	}
+
+	word = summary * WORD_BITS + findLastSet(bits);
+	++ ctx->numBucketScans;
+	return word * WORD_BITS + findLastSet(ctx->activeLabels[word]);
+}
+
+static void createActiveLabels(hpf_context *ctx, Arena *arena, uint numLabels)
+{
+/*************************************************************************
+createActiveLabels - Allocates the bitmaps of the strong root buckets of
+numLabels labels from arena, all empty. Region workers pass the arena of
+the context they were copied from, whose copy they must not allocate from.
+*************************************************************************/
+	uint numWords = numLabels / WORD_BITS + 1;
+	uint numSummaryWords = numWords / WORD_BITS + 1;
+
+	ctx->activeLabels = (ullint *)arenaAlloc(arena, numWords * sizeof(ullint));
+	ctx->activeLabelWords = (ullint *)arenaAlloc(arena, numSummaryWords * sizeof(ullint));
+	memset(ctx->activeLabels, 0, numWords * sizeof(ullint));
+	memset(ctx->activeLabelWords, 0, numSummaryWords * sizeof(ullint));
 }
 
-static void addToStrongBucket (Node *newRoot, Root *rootBucket)
+static void addToStrongBucket (hpf_context *ctx, Node *newRoot, uint label)
 {
 /*************************************************************************
-addToStrongBucket
+addToStrongBucket - Appends newRoot to the strong root bucket of label
 *************************************************************************/
+	Root *rootBucket = &ctx->strongRoots[label];
+
+	setActiveLabel(ctx, label);
 	if (rootBucket->start)
 	{
 		rootBucket->end->next = newRoot;
@@ -401,7 +905,7 @@ breakRelationship
 	child->next = NULL;
 }
 
-static void merge (Node *parent, Node *child, Arc *newArc)
+static void merge (hpf_context *ctx, Node *parent, Node *child, Arc *newArc)
 {
 /*************************************************************************
 merge
@@ -409,7 +913,7 @@ merge
 	Arc *oldArc;
 	Node *current = child, *oldParent, *newParent = parent;
 
-	++ numMergers;
+	++ ctx->numMergers;
 
 	while (current->parent)
 	{
@@ -429,12 +933,12 @@ merge
 }
 
 
-static __inline void pushUpward (Arc *currentArc, Node *child, Node *parent, const double resCap)
+static __inline void pushUpward (hpf_context *ctx, Arc *currentArc, Node *child, Node *parent, const Capacity resCap)
 {
 /*************************************************************************
 pushUpward
 *************************************************************************/
-	++ numPushes;
+	++ ctx->numPushes;
 
 	if (isExcess(resCap-child->excess) >= 0)//(/*(int)*/resCap >= child->excess)
 	{
@@ -448,20 +952,19 @@ pushUpward
 	parent->excess += resCap;
 	child->excess -= resCap;
 	currentArc->flow = currentArc->capacity;
-	parent->outOfTree[parent->numOutOfTree] = currentArc;
-	++ parent->numOutOfTree;
+	addOutOfTreeNode (ctx, parent, currentArc);
 	breakRelationship (parent, child);
 
-	addToStrongBucket (child, &strongRoots[child->label]);
+	addToStrongBucket (ctx, child, child->label);
 }
 
 
-static __inline void pushDownward (Arc *currentArc, Node *child, Node *parent, double flow)
+static __inline void pushDownward (hpf_context *ctx, Arc *currentArc, Node *child, Node *parent, Capacity flow)
 {
 /*************************************************************************
 pushDownward
 *************************************************************************/
-	++ numPushes;
+	++ ctx->numPushes;
 
 	if (isExcess(flow - child->excess) >= 0)//(/*(int)*/flow >= child->excess)
 	{
@@ -475,14 +978,13 @@ pushDownward
 	child->excess -= flow;
 	parent->excess += flow;
 	currentArc->flow = 0;
-	parent->outOfTree[parent->numOutOfTree] = currentArc;
-	++ parent->numOutOfTree;
+	addOutOfTreeNode (ctx, parent, currentArc);
 	breakRelationship (parent, child);
 
-	addToStrongBucket (child, &strongRoots[child->label]);
+	addToStrongBucket (ctx, child, child->label);
 }
 
-static void printCutProblem(CutProblem *p){
+static void printCutProblem(hpf_context *ctx, CutProblem *p){
     printf("numNodes: %u\n " ,p->numNodesInList);
     printf("numSource %u\n" ,p->numSourceSet);
     printf("numSink: %u\n" ,p->numSinkSet);
@@ -490,10 +992,10 @@ static void printCutProblem(CutProblem *p){
     printf("solved: %u\n" ,p->solved);
     printf("lambda:%.12lf\n" ,p->lambdaValue);
     int i;
-    printf("[from, to](capacity,constant,multiplier)\n");
+    printf("[from, to](capacity)\n");
     for(i=0;i<p->numArcs;++i)
     {
-        printf("[%d,%d](%.12lf,%.12lf,%.12lf)\n",p->arcList[i].from->originalIndex,p->arcList[i].to->originalIndex,p->arcList[i].capacity,p->arcList[i].constant,p->arcList[i].multiplier);
+        printf("[%d,%d](%.12lf)\n",p->originalIndex[p->arcList[i].from],p->originalIndex[p->arcList[i].to],(double) p->arcList[i].capacity);
     }
     printf("\n");
     //printArcListInfo(arcList);
@@ -504,27 +1006,27 @@ static void printCutProblem(CutProblem *p){
     if (p->solved == 1)
     {
 				int sourcenodes = 0;
-        for(i=0;i<numNodesSuper;++i)
+        for(i=0;i<ctx->numNodesSuper;++i)
         {
-					sourcenodes += p->optimalSourceSetIndicator[i];
-            printf("%u ",p->optimalSourceSetIndicator[i]);
+					sourcenodes += getBit(p->optimalSourceSetIndicator, i);
+            printf("%u ",getBit(p->optimalSourceSetIndicator, i));
         }
 				printf("\n");
 				printf("Nodes in source set: %d\n", sourcenodes);
     }
-    printf("SourceSuper: %d, SinkSuper: %d\n", sourceSuper, sinkSuper);
+    printf("SourceSuper: %d, SinkSuper: %d\n", ctx->sourceSuper, ctx->sinkSuper);
     printf("\n");
     printf("\n");
 }
 
-static void pushExcess (Node *strongRoot)
+static void pushExcess (hpf_context *ctx, Node *strongRoot)
 {
 /*************************************************************************
 pushExcess
 *************************************************************************/
 	Node *current, *parent;
 	Arc *arcToParent;
-	/*int*/double prevEx=1;
+	/*int*/Capacity prevEx=1;
 
 	for (current = strongRoot; (isExcess(current->excess) && current->parent); current = parent)
 	{
@@ -535,48 +1037,48 @@ pushExcess
 
 		if (arcToParent->direction)
 		{
-			pushUpward (arcToParent, current, parent, (arcToParent->capacity - arcToParent->flow));
+			pushUpward (ctx, arcToParent, current, parent, (arcToParent->capacity - arcToParent->flow));
 		}
 		else
 		{
-			pushDownward (arcToParent, current, parent, arcToParent->flow);
+			pushDownward (ctx, arcToParent, current, parent, arcToParent->flow);
 		}
 	}
 
 	if ((isExcess(current->excess) > 0) && (isExcess(prevEx) <= 0))
 	{
-		addToStrongBucket (current, &strongRoots[current->label]);
+		addToStrongBucket (ctx, current, current->label);
 	}
 }
 
 
-static Arc * findWeakNode (Node *strongNode, Node **weakNode)
+static Arc * findWeakNode (hpf_context *ctx, Node *strongNode, Node **weakNode)
 {
 /*************************************************************************
 findWeakNode
 *************************************************************************/
 	uint i, size;
+	uint *outOfTree = &ctx->outOfTreeArcs[ctx->outOfTreeStart[strongNode - ctx->nodesList]];
 	Arc *out;
 
 	size = strongNode->numOutOfTree;
 
 	for (i=strongNode->nextArc; i<size; ++i)
 	{
-		++ numArcScans;
-		if (strongNode->outOfTree[i]->to->label == (highestStrongLabel-1))
+		++ ctx->numArcScans;
+		out = &ctx->arcList[outOfTree[i]];
+		if (ctx->nodesList[out->to].label == (ctx->highestStrongLabel-1))
 		{
 			strongNode->nextArc = i;
-			out = strongNode->outOfTree[i];
-			(*weakNode) = out->to;
+			(*weakNode) = &ctx->nodesList[out->to];
 			-- strongNode->numOutOfTree;
-			strongNode->outOfTree[i] = strongNode->outOfTree[strongNode->numOutOfTree];
+			outOfTree[i] = outOfTree[strongNode->numOutOfTree];
 			return (out);
-		} else if (strongNode->outOfTree[i]->from->label == (highestStrongLabel-1)) {
+		} else if (ctx->nodesList[out->from].label == (ctx->highestStrongLabel-1)) {
 			strongNode->nextArc = i;
-			out = strongNode->outOfTree[i];
-			(*weakNode) = out->from;
+			(*weakNode) = &ctx->nodesList[out->from];
 			-- strongNode->numOutOfTree;
-			strongNode->outOfTree[i] = strongNode->outOfTree[strongNode->numOutOfTree];
+			outOfTree[i] = outOfTree[strongNode->numOutOfTree];
 			return (out);
 		}
 	}
@@ -587,7 +1089,7 @@ findWeakNode
 }
 
 
-static void checkChildren (Node *curNode)
+static void checkChildren (hpf_context *ctx, Node *curNode)
 {
 /*************************************************************************
 checkChildren
@@ -601,61 +1103,64 @@ checkChildren
 
 	}
 
-	-- labelCount[curNode->label];
+	-- ctx->labelCount[curNode->label];
 	++	curNode->label;
-	++ labelCount[curNode->label];
+	++ ctx->labelCount[curNode->label];
 
-	++numRelabels;
+	++ctx->numRelabels;
 
 	curNode->nextArc = 0;
 }
 
 
-static void simpleInitialization (void)
+static void simpleInitialization (hpf_context *ctx)
 {
 /*************************************************************************
 simpleInitialization
 *************************************************************************/
 	uint i, size;
+	uint *outOfTree;
 	Arc *tempArc;
 
-	size = nodesList[source].numOutOfTree;
+	size = ctx->nodesList[ctx->source].numOutOfTree;
+	outOfTree = &ctx->outOfTreeArcs[ctx->outOfTreeStart[ctx->source]];
 	for (i=0; i<size; ++i) // Saturating source adjacent nodes
 	{
-		tempArc = nodesList[source].outOfTree[i];
+		tempArc = &ctx->arcList[outOfTree[i]];
 		tempArc->flow = tempArc->capacity;
-		tempArc->to->excess += tempArc->capacity;
+		ctx->nodesList[tempArc->to].excess += tempArc->capacity;
 	}
 
-	size = nodesList[sink].numOutOfTree;
+	size = ctx->nodesList[ctx->sink].numOutOfTree;
+	outOfTree = &ctx->outOfTreeArcs[ctx->outOfTreeStart[ctx->sink]];
 	for (i=0; i<size; ++i) // Pushing maximum flow on sink adjacent nodes
 	{
-		tempArc = nodesList[sink].outOfTree[i];
+		tempArc = &ctx->arcList[outOfTree[i]];
 		tempArc->flow = tempArc->capacity;
-		tempArc->from->excess -= tempArc->capacity;
+		ctx->nodesList[tempArc->from].excess -= tempArc->capacity;
 	}
 
-	nodesList[source].excess = 0; // zeroing source excess
-	nodesList[sink].excess = 0;	// zeroing sink excess
+	ctx->nodesList[ctx->source].excess = 0; // zeroing source excess
+	ctx->nodesList[ctx->sink].excess = 0;	// zeroing sink excess
 
-	for (i=0; i<numNodes; ++i)
+	for (i=0; i<ctx->numNodes; ++i)
 	{
-		if (isExcess(nodesList[i].excess) > 0)
+		if (isExcess(ctx->nodesList[i].excess) > 0)
 		{
-		    nodesList[i].label = 1;
-			++ labelCount[1];
+		    ctx->nodesList[i].label = 1;
+			++ ctx->labelCount[1];
 
-			addToStrongBucket (&nodesList[i], &strongRoots[1]);
+			addToStrongBucket (ctx, &ctx->nodesList[i], 1);
 		}
 	}
 
-	nodesList[source].label = numNodes;	// Set the source label to n
-	nodesList[sink].label = 0;			// set the sink label to 0
-	labelCount[0] = (numNodes - 2) - labelCount[1];
+	ctx->nodesList[ctx->source].label = ctx->numNodes;	// Set the source label to n
+	ctx->nodesList[ctx->sink].label = 0;			// set the sink label to 0
+	ctx->labelCount[0] = (ctx->numNodes - 2) - ctx->labelCount[1];
 }
 
 
-static Node* getHighestStrongRoot (void)
+static Node* getHighestStrongRoot (hpf_context *ctx)
 {
 /*************************************************************************
 getHighestStrongRoot
@@ -663,53 +1168,61 @@ getHighestStrongRoot
 	uint i;
 	Node *strongRoot;
 
-	for (i=highestStrongLabel; i>0; --i)
+	/* only the nonempty buckets are visited */
+	for (i=highestActiveLabel(ctx, ctx->highestStrongLabel); i>0; i=highestActiveLabel(ctx, i-1))
 	{
-		if (strongRoots[i].start)
+		ctx->highestStrongLabel = i;
+		if (ctx->labelCount[i-1])
 		{
-			highestStrongLabel = i;
-			if (labelCount[i-1])
+			strongRoot = ctx->strongRoots[i].start;
+			ctx->strongRoots[i].start = strongRoot->next;
+			strongRoot->next = NULL;
+			if (!ctx->strongRoots[i].start)
 			{
-				strongRoot = strongRoots[i].start;
-				strongRoots[i].start = strongRoot->next;
-				strongRoot->next = NULL;
-				return strongRoot;
+				clearActiveLabel(ctx, i);
 			}
+			return strongRoot;
+		}
 
-			while (strongRoots[i].start)
-			{
-				++ numGaps;
+		while (ctx->strongRoots[i].start)
+		{
+			++ ctx->numGaps;
 
-				strongRoot = strongRoots[i].start;
-				strongRoots[i].start = strongRoot->next;
-				liftAll (strongRoot);
-			}
+			strongRoot = ctx->strongRoots[i].start;
+			ctx->strongRoots[i].start = strongRoot->next;
+			liftAll (ctx, strongRoot);
 		}
+		clearActiveLabel(ctx, i);
 	}
 
-	if (!strongRoots[0].start)
+	if (!ctx->strongRoots[0].start)
 	{
 		return NULL;
 	}
 
-	while (strongRoots[0].start)
+	while (ctx->strongRoots[0].start)
 	{
-		strongRoot = strongRoots[0].start;
-		strongRoots[0].start = strongRoot->next;
+		strongRoot = ctx->strongRoots[0].start;
+		ctx->strongRoots[0].start = strongRoot->next;
 		strongRoot->label = 1;
-		-- labelCount[0];
-		++ labelCount[1];
+		-- ctx->labelCount[0];
+		++ ctx->labelCount[1];
 
-		++ numRelabels;
+		++ ctx->numRelabels;
 
-		addToStrongBucket (strongRoot, &strongRoots[strongRoot->label]);
+		addToStrongBucket (ctx, strongRoot, strongRoot->label);
 	}
+	clearActiveLabel(ctx, 0);
 
-	highestStrongLabel = 1;
+	ctx->highestStrongLabel = 1;
 
-	strongRoot = strongRoots[1].start;
-	strongRoots[1].start = strongRoot->next;
+	strongRoot = ctx->strongRoots[1].start;
+	ctx->strongRoots[1].start = strongRoot->next;
 	strongRoot->next = NULL;
+	if (!ctx->strongRoots[1].start)
+	{
+		clearActiveLabel(ctx, 1);
+	}
 
 	return strongRoot;
 }
@@ -726,7 +1239,7 @@ initializeRoot
 }
 
 
-static void initializeNode (Node *nd, const uint n)
+static void initializeNode (Node *nd)
 {
 /*************************************************************************
 initializeNode
@@ -740,11 +1253,6 @@ initializeNode
 	nd->numOutOfTree = 0;
 	nd->arcToParent = NULL;
 	nd->next = NULL;
-	nd->visited = 0;
-	nd->numAdjacent = 0;
-	nd->number = n;
-	nd->originalIndex = -10;
-	nd->outOfTree = NULL;
 }
 
 static void destroyBreakpoint(Breakpoint *currentBreakpoint)
@@ -778,50 +1286,48 @@ freeRoot
 	rt->end = NULL;
 }
 
-static void freeMemoryComplete(void)
+static void freeMemoryComplete(hpf_context *ctx)
 /*************************************************************************
 freeMemoryComplete
 *************************************************************************/
 {
 	/* destroy breakpoints */
-	destroyBreakpoint(firstBreakpoint);
-	firstBreakpoint = NULL;
-
-	free(nodeListSuper);
-	nodeListSuper = NULL;
-	free(arcListSuper);
-	arcListSuper = NULL;
+	destroyBreakpoint(ctx->firstBreakpoint);
+	ctx->firstBreakpoint = NULL;
+
+	/* the super graph and the workspace live in the scratch arena */
+	ctx->arcListSuper = NULL;
+	ctx->constantSuper = NULL;
+	ctx->multiplierSuper = NULL;
+	ctx->fixedSourceSet = NULL;
+	ctx->fixedSinkSet = NULL;
+	ctx->nodeMap = NULL;
+	ctx->sourceAdjacentArcIndices = NULL;
+	ctx->sinkAdjacentArcIndices = NULL;
 }
 
-static void freeMemorySolve (void)
+static void freeMemorySolve (hpf_context *ctx)
 {
 /*************************************************************************
 freeMemorySolve
 *************************************************************************/
 	uint i;
 
-	for (i=0; i<numNodes; ++i)
-	{
-		freeRoot (&strongRoots[i]);
-	}
-
-	free(strongRoots);
-	strongRoots = NULL;
-
-	for (i=0; i<numNodes; ++i)
+	for (i=0; i<ctx->numNodes; ++i)
 	{
-		if (nodesList[i].outOfTree)
-		{
-			free(nodesList[i].outOfTree);
-			nodesList[i].outOfTree = NULL;
-		}
+		freeRoot (&ctx->strongRoots[i]);
 	}
 
-	free(labelCount);
-	labelCount = NULL;
+	/* the memory itself is released by rewinding the scratch arena */
+	ctx->strongRoots = NULL;
+	ctx->activeLabels = NULL;
+	ctx->activeLabelWords = NULL;
+	ctx->outOfTreeStart = NULL;
+	ctx->outOfTreeArcs = NULL;
+	ctx->labelCount = NULL;
 }
 
-static void processRoot (Node *strongRoot)
+static void processRoot (hpf_context *ctx, Node *strongRoot)
 {
 /*************************************************************************
 processRoot
@@ -831,14 +1337,14 @@ processRoot
 
 	strongRoot->nextScan = strongRoot->childList;
 
-	if ((out = findWeakNode (strongRoot, &weakNode)))
+	if ((out = findWeakNode (ctx, strongRoot, &weakNode)))
 	{
-		merge (weakNode, strongNode, out);
-		pushExcess (strongRoot);
+		merge (ctx, weakNode, strongNode, out);
+		pushExcess (ctx, strongRoot);
 		return;
 	}
 
-	checkChildren (strongRoot);
+	checkChildren (ctx, strongRoot);
 
 	while (strongNode)
 	{
@@ -849,51 +1355,52 @@ processRoot
 			strongNode = temp;
 			strongNode->nextScan = strongNode->childList;
 
-			if ((out = findWeakNode (strongNode, &weakNode)))
+			if ((out = findWeakNode (ctx, strongNode, &weakNode)))
 			{
-				merge (weakNode, strongNode, out);
-				pushExcess (strongRoot);
+				merge (ctx, weakNode, strongNode, out);
+				pushExcess (ctx, strongRoot);
 				return;
 			}
 
-			checkChildren (strongNode);
+			checkChildren (ctx, strongNode);
 		}
 
 		if ((strongNode = strongNode->parent))
 		{
-			checkChildren (strongNode);
+			checkChildren (ctx, strongNode);
 		}
 	}
 
-	addToStrongBucket (strongRoot, &strongRoots[strongRoot->label]);
-	++ highestStrongLabel;
+	addToStrongBucket (ctx, strongRoot, strongRoot->label);
+	++ ctx->highestStrongLabel;
 }
 
 
-static __inline void quickSort (Arc **arr, const uint first, const uint last)
+static __inline void quickSort (Arc *arcList, uint *arr, const uint first, const uint last)
 {
 /*************************************************************************
-quickSort
+quickSort - Sorts the arc indices in arr by decreasing flow
 *************************************************************************/
 	int i=0, j, L=first, R=last, beg[MAX_LEVELS], end[MAX_LEVELS], temp=0;
-	Arc *swap;
+	uint swap, swapped;
 
 	if ((R-L) <= 5)
 	{// Bubble sort if 5 elements or less
 		for (i=R; (i>L); --i)
 		{
-			swap = NULL;
+			swapped = 0;
 			for (j=L; j<i; ++j)
 			{
-				if (isExcess(arr[j]->flow - arr[j+1]->flow) < 0)//(arr[j]->flow < arr[j+1]->flow)
+				if (isExcess(arcList[arr[j]].flow - arcList[arr[j+1]].flow) < 0)//(arr[j]->flow < arr[j+1]->flow)
 				{
 					swap = arr[j];
 					arr[j] = arr[j+1];
 					arr[j+1] = swap;
+					swapped = 1;
 				}
 			}
 
-			if (!swap)
+			if (!swapped)
 			{
 				return;
 			}
@@ -915,7 +1422,7 @@ quickSort
 			swap=arr[L];
 			while (L<R)
 			{
-				while ((isExcess(arr[R]->flow - swap->flow)>=0) && (L<R)) //((arr[R]->flow >= swap->flow) && (L<R))
+				while ((isExcess(arcList[arr[R]].flow - arcList[swap].flow)>=0) && (L<R)) //((arr[R]->flow >= swap->flow) && (L<R))
 					R--;
 
 				if (L<R)
@@ -924,7 +1431,7 @@ quickSort
 					L++;
 				}
 
-				while ((isExcess(arr[L]->flow - swap->flow) <= 0) && (L<R)) //((arr[L]->flow <= swap->flow) && (L<R))
+				while ((isExcess(arcList[arr[L]].flow - arcList[swap].flow) <= 0) && (L<R)) //((arr[L]->flow <= swap->flow) && (L<R))
 					L++;
 
 				if (L<R)
@@ -957,1317 +1464,4243 @@ quickSort
 	}
 }
 
-static __inline void sort (Node * current)
+static __inline void sort (hpf_context *ctx, Node * current)
 {
 /*************************************************************************
 sort
 *************************************************************************/
 	if (current->numOutOfTree > 1)
 	{
-		quickSort (current->outOfTree, 0, (current->numOutOfTree-1));
+		quickSort (ctx->arcList, &ctx->outOfTreeArcs[ctx->outOfTreeStart[current - ctx->nodesList]], 0, (current->numOutOfTree-1));
 	}
 }
 
-static __inline void minisort (Node *current)
+static __inline void minisort (hpf_context *ctx, Node *current)
 {
 /*************************************************************************
 minisort
 *************************************************************************/
-	Arc *temp = current->outOfTree[current->nextArc];
+	uint *outOfTree = &ctx->outOfTreeArcs[ctx->outOfTreeStart[current - ctx->nodesList]];
+	uint temp = outOfTree[current->nextArc];
 	uint i, size = current->numOutOfTree;/*, tempflow = temp->flow;*/
-	double tempflow = temp->flow;
-
-	for(i=current->nextArc+1; ((i<size) && (isExcess(tempflow - current->outOfTree[i]->flow) < 0)); ++i)
-	{
-		current->outOfTree[i-1] = current->outOfTree[i];
-	}
-	current->outOfTree[i-1] = temp;
-}
-
-
-// static /*ullint*/double checkOptimality (const uint gap)
-// {
-// /*************************************************************************
-// checkOptimality
-// *************************************************************************/
-// 	uint i, check = 1;
-// 	/*ullint*/double mincut = 0;
-// 	/*llint*/ double *excess = NULL;
-//
-// 	Arc *tempArc;
-//
-// 	excess = (/*llint*/double *) malloc (numNodes * sizeof (double/*llint*/));
-// 	if (!excess)
-// 	{
-// 		printf("Out of memory\n");
-// 		exit(0);
-// 	}
-//
-// 	// Pushing depicits from all sink adjacent nodes to the sink
-// 	for (i=0; i<nodesList[sink].numOutOfTree; ++i)
-// 	{
-// 		tempArc = nodesList[sink].outOfTree[i];
-// 		if (isExcess(tempArc->from->excess) < 0)
-// 		{
-// 			if (isExcess((tempArc->from->excess + /*(int)*/ tempArc->flow))  < 0)
-// 			{
-// 				// Excess is high enough to saturate the arc => Flow on residual arc is zeroed
-// 				tempArc->from->excess += /*(int)*/ tempArc->flow;
-// 				tempArc->flow = 0;
-// 			}
-// 			else
-// 				// Excess is NOT high enough to saturate the arc => Excess is zeroed
-// 			{
-// 				tempArc->flow = /*(uint)*/ (tempArc->from->excess + /*(int)*/ tempArc->flow);
-// 				tempArc->from->excess = 0;
-// 			}
-// 		}
-// 	}
-//
-// 	for (i=0; i<numNodes; ++i)
-// 	{
-// 		excess[i] = 0;
-// 	}
-//
-// 	for (i=0; i<numArcs; ++i)
-// 	{
-// 		if ((arcList[i].from->label >= gap) && (arcList[i].to->label < gap))
-// 		{
-// 			mincut += arcList[i].capacity;
-// 		}
-//
-// 		if ((isExcess(arcList[i].flow - arcList[i].capacity)>0) || (isExcess(arcList[i].flow) < 0))
-// 		{
-// 			check = 0;
-// 			printf("Warning - Capacity constraint violated on arc (%d, %d). Flow = %lf, capacity = %lf\n",
-// 				   arcList[i].from->number,
-// 				   arcList[i].to->number,
-// 				   arcList[i].flow,
-// 				   arcList[i].capacity);
-// 		}
-// 		excess[arcList[i].from->number - 1] -= arcList[i].flow;
-// 		excess[arcList[i].to->number - 1] += arcList[i].flow;
-// 	}
-//
-// 	for (i=0; i<numNodes; i++)
-// 	{
-// 		if ((i != (source)) && (i != (sink)))
-// 		{
-// 			if (isExcess(excess[i]))
-// 			{
-// 				check = 0;
-// 				printf ("Warning - Flow balance constraint violated in node %d. Excess = %lf\n",
-// 						i+1,
-// 						excess[i]);
-// 			}
-// 		}
-// 	}
-//
-// 	check = 1;
-//
-// 	if (isExcess(excess[sink] - mincut) != 0)//(excess[sink] != mincut)
-// 	{
-// 		check = 0;
-// 		printf("Warning - Flow is not optimal - max flow does not equal min cut!\n");
-// 	}
-//
-// // 	if (check)
-// // 	{
-// // 		printf ("Solution checks as optimal. \t Max Flow: \t %lld\n", mincut);
-// // 	}
-//
-// 	free (excess);
-// 	excess = NULL;
-// 	return mincut;
-// }
-
-// static void decompose (Node *excessNode, const uint source, uint *iteration)
-// {
-// /*************************************************************************
-// decompose
-// *************************************************************************/
-// 	Node *current = excessNode;
-// 	Arc *tempArc;
-// 	/*uint*/double bottleneck = excessNode->excess;
-//
-// 	// Find the bottleneck along a path to the source or on a cycle
-// 	for ( ;(current->number != source) && (current->visited < (*iteration)) /*&& (current->nextArc < current->numOutOfTree)*/; // Added by Cheng
-// 		 current = tempArc->from)
-// 	{
-// 		current->visited = (*iteration);
-// 		tempArc = current->outOfTree[current->nextArc];
-//
-// 		if (isExcess(tempArc->flow - bottleneck) < 0) //(tempArc->flow < bottleneck)
-// 		{
-// 			bottleneck = tempArc->flow;
-// 		}
-// 	}
-//
-// 	if (current->number == source) // the DFS reached the source
-// 	{
-// 		excessNode->excess -= bottleneck;
-// 		current = excessNode;
-//
-// 		// Push the excess all the way to the source
-// 		while (current->number != source)
-// 		{
-// 			tempArc = current->outOfTree[current->nextArc]; // Pick arc going out of node to push excess to
-// 			tempArc->flow -= bottleneck; // Push back bottleneck excess on this arc
-//
-// 			if (isFlow(tempArc->flow)) // If there is still flow on this arc do sort on this current node
-// 			{
-// 				minisort(current);
-// 			} else {
-// 				++ current->nextArc;
-// 			}
-//
-// 			current = tempArc->from;
-// 		}
-// 		return;
-// 	}
-//
-// 	++ (*iteration);
-//
-// 	// This part is temporarily added by Cheng Lu.
-// //	if (current->visited == (*iteration)-1)
-// 		bottleneck = current->outOfTree[current->nextArc]->flow;
-// /*	else{
-// 		current = excessNode;
-// 		bottleneck = excessNode->excess;
-// 	}*/
-//
-// 	while (current->visited < (*iteration)) //&& (current->nextArc < current->numOutOfTree)) // Added by Cheng
-// 	{
-// 		current->visited = (*iteration);
-// 		tempArc = current->outOfTree[current->nextArc];
-//
-// 		if (isExcess(tempArc->flow - bottleneck) < 0)//(tempArc->flow < bottleneck)
-// 		{
-// 			bottleneck = tempArc->flow;
-// 		}
-// 		current = tempArc->from;
-// 	}
-//
-// 	++ (*iteration);
-//
-// 	// This part is temporarily added by Cheng Lu.
-// /*	if (current->visited == (*iteration)-1)
-// 		;
-// 	else{
-// 		current = excessNode;
-// 	}*/
-//
-// 	while (current->visited < (*iteration)) //&& (current->nextArc < current->numOutOfTree)) // Added by Cheng
-// 	{
-// 		current->visited = (*iteration);
-//
-// 		tempArc = current->outOfTree[current->nextArc];
-// 		tempArc->flow -= bottleneck;
-//
-// 		if (isFlow(tempArc->flow))
-// 		{
-// 			minisort(current);
-// 			current = tempArc->from;
-// 		} else {
-// 			++ current->nextArc;
-// 			current = tempArc->from;
-// 		}
-// 	}
-// }
-
-// static void recoverFlow (const uint gap)
-// {
-// /*************************************************************************
-// recoverFlow
-// *************************************************************************/
-// 	uint iteration = 1;
-// 	uint i, j;
-// 	Arc *tempArc;
-// 	Node *tempNode;
-//
-// 	Node **nodePtrArray;
-//
-// 	if ((nodePtrArray = (Node **) malloc (numNodes * sizeof (Node *))) == NULL)
-// 	{
-// 		printf("Out of memory\n");
-// 		exit(0);
-// 	}
-//
-// 	for (i=0; i < numNodes ; i++)
-// 		nodePtrArray[i] = &nodesList[i];
-//
-// 	// Adding arcs FROM the Source to Source adjacent nodes.
-// 	for (i=0; i<nodesList[source].numOutOfTree; ++i)
-// 	{
-// 		tempArc = nodesList[source].outOfTree[i];
-// 		addOutOfTreeNode (tempArc->to, tempArc);
-// 	}
-//
-// 	// Zeroing excess on source and sink nodes
-// 	nodesList[source].excess = 0;
-// 	nodesList[sink].excess = 0;
-//
-// 	for (i=0; i<numNodes; ++i)
-// 	{
-// 		tempNode = &nodesList[i];
-//
-// 		if ((i == (source)) || (i == (sink)))
-// 		{
-// 			continue;
-// 		}
-//
-// 		if (tempNode->label >= gap) //tempNode is in SINK set
-// 		{
-// 			tempNode->nextArc = 0;
-// 			if ((tempNode->parent) && (isFlow(tempNode->arcToParent->flow)))
-// 			{
-// 				addOutOfTreeNode (tempNode->arcToParent->to, tempNode->arcToParent);
-// 			}
-//
-// 			for (j=0; j<tempNode->numOutOfTree; ++j)
-// 			{ // go over all sink-set-node's arcs and look for arc with NO flow
-// 				if (!isFlow(tempNode->outOfTree[j]->flow))
-// 				{	// Remove arc with no flow
-// 					-- tempNode->numOutOfTree;
-// 					tempNode->outOfTree[j] = tempNode->outOfTree[tempNode->numOutOfTree];
-// 					-- j;
-// 				}
-// 			}
-//
-// 			sort(tempNode);
-// 		}
-// 	}
-//
-// 	for (i=lowestPositiveExcessNode ; i < numNodes ; ++i)
-// 	{
-// 		tempNode = nodePtrArray[i];
-// 		while (isExcess(tempNode->excess) > 0)
-// 		{
-// 			++ iteration;
-// 			decompose(tempNode, source, &iteration);
-// 		}
-// 	}
-//
-// 	free(nodePtrArray);
-// 	nodePtrArray = NULL;
-// }
-
-static void readGraphSuper(double * arcMatrix)
-/*************************************************************************
-readData
-*************************************************************************/
-{
-	if ((nodeListSuper = (Node *)malloc(numNodesSuper * sizeof(Node))) == NULL)
-	{
-		printf("Could not allocate memory.\n");
-		exit(0);
-	}
-	if ((arcListSuper = (Arc *)malloc(numArcsSuper * sizeof(Arc))) == NULL)
-	{
-		printf("Could not allocate memory.\n");
-		exit(0);
-	}
+	Capacity tempflow = ctx->arcList[temp].flow;
 
-	/* Initialization */
-	for (int i = 0; i < numNodesSuper; ++i)
+	for(i=current->nextArc+1; ((i<size) && (isExcess(tempflow - ctx->arcList[outOfTree[i]].flow) < 0)); ++i)
 	{
-		initializeNode(&nodeListSuper[i], i);
-		nodeListSuper[i].originalIndex = i;
+		outOfTree[i-1] = outOfTree[i];
 	}
+	outOfTree[i-1] = temp;
+}
+
+
+static void listFlowArcs (hpf_context *ctx, uint towardsSource)
+{
+/*************************************************************************
+listFlowArcs - Replaces the out of tree arcs of every node by its arcs
+with flow, sorted by decreasing flow: the arcs into the node if
+towardsSource is set, and the arcs out of it otherwise. nextArc is the
+first arc of the list that still has flow.
+*************************************************************************/
+	uint i;
+	Arc *arc;
 
-	for (int i = 0; i < numArcsSuper; ++i)
+	for (i=0; i<ctx->numNodes; ++i)
 	{
-		initializeArc(&arcListSuper[i]);
+		ctx->nodesList[i].numOutOfTree = 0;
+		ctx->nodesList[i].nextArc = 0;
 	}
 
-	if (LAMBDA_LOW == LAMBDA_HIGH)
+	for (i=0; i<ctx->numArcs; ++i)
 	{
-		useParametricCut = 0;
+		arc = &ctx->arcList[i];
+		if (isFlow(arc->flow))
+		{
+			addOutOfTreeNode (ctx, &ctx->nodesList[towardsSource ? arc->to : arc->from], arc);
+		}
 	}
 
-	for (int i=0; i < numArcsSuper; ++i)
+	for (i=0; i<ctx->numNodes; ++i)
 	{
-		int from = (int) arcMatrix[i * 4 + 0];
-		int to = (int) arcMatrix[i * 4 + 1];
-		double constantCapacity = arcMatrix[ i * 4 + 2 ];
-		double multiplierCapacity = arcMatrix[ i * 4 + 3 ];
-
-		arcListSuper[i].constant = constantCapacity;
-		arcListSuper[i].multiplier = multiplierCapacity;
-		arcListSuper[i].from = &nodeListSuper[from];
-		arcListSuper[i].to = &nodeListSuper[to];
-
-		++nodeListSuper[from].numAdjacent;
-		++nodeListSuper[to].numAdjacent;
+		sort (ctx, &ctx->nodesList[i]);
 	}
 }
 
-static void pseudoflowPhase1 (void)
+static __inline Arc * nextFlowArc (hpf_context *ctx, Node *current)
 {
 /*************************************************************************
-pseudoflowPhase1
+nextFlowArc - The arc of current with the most flow, see listFlowArcs
 *************************************************************************/
-	Node *strongRoot;
-	while ((strongRoot = getHighestStrongRoot ()))
-	{
-		processRoot (strongRoot);
-	}
+	return &ctx->arcList[ctx->outOfTreeArcs[ctx->outOfTreeStart[current - ctx->nodesList] + current->nextArc]];
 }
 
-static void prepareOutput (int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5] )
+static __inline Node * flowNeighbor (hpf_context *ctx, Arc *arc, uint towardsSource)
 {
 /*************************************************************************
-printOutput
+flowNeighbor - The next node of a path along arc, see decompose
 *************************************************************************/
-	Breakpoint *currentBreakpoint;
-	int i;
-	int j;
+	return &ctx->nodesList[towardsSource ? arc->from : arc->to];
+}
 
-	stats[0] = numArcScans;
-	stats[1] = numMergers;
-	stats[2] = numPushes;
-	stats[3] = numRelabels;
-	stats[4] = numGaps;
+static __inline void reduceFlow (hpf_context *ctx, Node *current, Capacity bottleneck)
+{
+/*************************************************************************
+reduceFlow - Removes bottleneck from the flow of the next arc of current,
+and moves the arc to its place in the list or past its end
+*************************************************************************/
+	Arc *arc = nextFlowArc (ctx, current);
 
-	/* count num breakpoints */
-	*numBreakpoints = 0;
-	currentBreakpoint = firstBreakpoint;
-	while (currentBreakpoint != NULL)
+	arc->flow -= bottleneck;
+	if (isFlow(arc->flow))
 	{
-		++*numBreakpoints;
-		currentBreakpoint = currentBreakpoint->next;
+		minisort (ctx, current);
 	}
-
-	double* breakpointsPointer;
-	/* print lambda values */
-	if ((breakpointsPointer = (double *)malloc(*numBreakpoints * sizeof(double))) == NULL)
+	else
 	{
-		printf("Could not allocate memory.\n");
-		exit(0);
+		++ current->nextArc;
 	}
+}
 
-	currentBreakpoint = firstBreakpoint;
-	for (i = 0; i < *numBreakpoints; i++)
-	{
-		breakpointsPointer[i] = (double) currentBreakpoint->lambdaValue;
-		currentBreakpoint = currentBreakpoint->next;
-	}
+static void decompose (hpf_context *ctx, Node *excessNode, uint towardsSource, uint *visited, uint *iteration)
+{
+/*************************************************************************
+decompose - Returns the excess of excessNode to the source, or its deficit
+to the sink if towardsSource is not set, along a path of arcs with flow,
+as far as the smallest flow on the path allows. A path to the source also
+ends at a node with a deficit, which takes the excess. If the path runs
+into a cycle, the smallest flow on the cycle is cancelled instead.
+*************************************************************************/
+	Node *end = &ctx->nodesList[towardsSource ? ctx->source : ctx->sink];
+	Node *current = excessNode, *next;
+	Capacity sign = towardsSource ? 1 : -1;
+	Capacity bottleneck = sign * excessNode->excess;
+	Arc *arc;
 
-	*breakpoints = breakpointsPointer;
+	++ (*iteration);
 
-	/* print values nodes*/
-	int* cutsPointer;
-	if ((cutsPointer = (int *)malloc(*numBreakpoints * (int) numNodesSuper * sizeof(int))) == NULL)
+	// Find the bottleneck along the path to the end or on a cycle
+	while ((current != end) && (visited[current - ctx->nodesList] != (*iteration)))
 	{
-		printf("Could not allocate memory.\n");
-		exit(0);
+		/* without arcs, the node keeps what is left of the flow due to
+		   rounding, which ends the path as well */
+		if ((current != excessNode) && ((current->nextArc >= current->numOutOfTree) || (towardsSource && isExcess(current->excess) < 0)))
+		{
+			break;
+		}
+
+		visited[current - ctx->nodesList] = (*iteration);
+		arc = nextFlowArc (ctx, current);
+		if (isExcess(arc->flow - bottleneck) < 0)
+		{
+			bottleneck = arc->flow;
+		}
+		current = flowNeighbor (ctx, arc, towardsSource);
 	}
 
-	currentBreakpoint = firstBreakpoint;
-	for (i = 0; i < *numBreakpoints; i++)
+	if ((current == end) || (visited[current - ctx->nodesList] != (*iteration)))
 	{
-		for (j = 0; j < numNodesSuper; j++)
+		if (towardsSource && (current != end) && (isExcess(current->excess) < 0) && (isExcess(current->excess + bottleneck) > 0))
 		{
-			cutsPointer[i * numNodesSuper + j ] = (int) currentBreakpoint->sourceSetIndicator[j];
+			bottleneck = - current->excess;
 		}
-		currentBreakpoint = currentBreakpoint->next;
-	}
 
-	*cuts = cutsPointer;
-}
-
-static void copyArcNew(CutProblem *problem, int *nodeMap, Arc *old, Arc *new, double lambda)
-/*************************************************************************
-copyArcNew - copy basic info arc and point to new nodes
-*************************************************************************/
-{
-	uint newIndexFrom;
-	uint newIndexTo;
-
-	initializeArc(new);
-	new->capacity = old->multiplier * lambda + old->constant;
-
-    if (new->capacity < 0)
-    {
-        if (roundNegativeCapacity)
-        {
-            new->capacity = 0;
-        }
-        else
-        {
-            printf("Negative capacity for lambda equal to %f. Set roundNegativeCapacity to 1 if the value should be rounded to 0.\n",problem->lambdaValue);
-            exit(0);
-        }
-    }
+		// Return the bottleneck along the path
+		excessNode->excess -= sign * bottleneck;
+		if (current != end)
+		{
+			current->excess += sign * bottleneck;
+		}
 
+		for (next = excessNode; next != current; )
+		{
+			arc = nextFlowArc (ctx, next);
+			reduceFlow (ctx, next, bottleneck);
+			next = flowNeighbor (ctx, arc, towardsSource);
+		}
+		return;
+	}
 
-	/* set start and end node */
-	newIndexFrom = nodeMap[old->from->number];
-	newIndexTo = nodeMap[old->to->number];
-	new->from = &problem->nodeList[newIndexFrom];
-	new->to = &problem->nodeList[newIndexTo];
+	// Cancel the cycle through current
+	arc = nextFlowArc (ctx, current);
+	bottleneck = arc->flow;
+	for (next = flowNeighbor (ctx, arc, towardsSource); next != current; next = flowNeighbor (ctx, arc, towardsSource))
+	{
+		arc = nextFlowArc (ctx, next);
+		if (isExcess(arc->flow - bottleneck) < 0)
+		{
+			bottleneck = arc->flow;
+		}
+	}
 
-	/* update degree nodes*/
-	++ new->from->numAdjacent;
-	++ new->to->numAdjacent;
+	next = current;
+	do
+	{
+		arc = nextFlowArc (ctx, next);
+		reduceFlow (ctx, next, bottleneck);
+		next = flowNeighbor (ctx, arc, towardsSource);
+	} while (next != current);
 }
 
-static void copyArcAdd(Arc *old, Arc *new, double lambda)
+static void recoverFlow (hpf_context *ctx)
+{
 /*************************************************************************
-copyArcAdd - update arc by adding another
+recoverFlow - Turns the pseudoflow at the end of phase 1 into a maximum
+flow with the same cut. The excesses of the source set are returned to
+the source, and then the deficits of the sink set to the sink, by
+decomposing the flow into paths and cycles. The arcs of every node are
+used in order of decreasing flow, which keeps the number of paths small.
 *************************************************************************/
+	uint iteration = 0;
+	uint i;
+	uint *visited = (uint *) arenaAlloc (&ctx->scratch, ctx->numNodes * sizeof (uint));
+	Node *tempNode;
 
-{
-    double additional_capacity = old->multiplier * lambda + old->constant;
+	for (i=0; i<ctx->numNodes; ++i)
+	{
+		visited[i] = 0;
+	}
 
-    if (additional_capacity < 0)
-    {
-        if (roundNegativeCapacity)
-        {
-            additional_capacity = 0;
-        }
-        else
-        {
-            printf("Negative capacity for lambda equal to %f. Set roundNegativeCapacity to 1 if the value should be rounded to 0.\n", lambda);
-            exit(0);
-        }
-    }
-    new->capacity +=  additional_capacity;
-}
+	listFlowArcs (ctx, 1);
+	for (i=0; i<ctx->numNodes; ++i)
+	{
+		tempNode = &ctx->nodesList[i];
+		if ((i == ctx->source) || (i == ctx->sink))
+		{
+			continue;
+		}
 
-static void destroyProblem(CutProblem *problem, int destroySourceSetIndicator)
-/*************************************************************************
-destroyProblem - Destruct function for CutProblem struct
-*************************************************************************/
-{
-	free(problem->sourceSet);
-	problem->sourceSet = NULL;
-	free(problem->sinkSet);
-	problem->sinkSet = NULL;
-	free(problem->nodeList);
-	problem->nodeList = NULL;
-	free(problem->arcList);
-	problem->arcList = NULL;
-    if (destroySourceSetIndicator)
-    {
-        free(problem->optimalSourceSetIndicator);
-        problem->optimalSourceSetIndicator = NULL;
-    }
+		while ((isExcess(tempNode->excess) > 0) && (tempNode->nextArc < tempNode->numOutOfTree))
+		{
+			decompose (ctx, tempNode, 1, visited, &iteration);
+		}
+	}
+
+	listFlowArcs (ctx, 0);
+	for (i=0; i<ctx->numNodes; ++i)
+	{
+		tempNode = &ctx->nodesList[i];
+		if ((i == ctx->source) || (i == ctx->sink))
+		{
+			continue;
+		}
+
+		while ((isExcess(tempNode->excess) < 0) && (tempNode->nextArc < tempNode->numOutOfTree))
+		{
+			decompose (ctx, tempNode, 0, visited, &iteration);
+		}
+	}
 }
 
-static void initializeContractedProblem(CutProblem *problem, Node *nodeListProblem, uint numNodesProblem, Arc *arcListProblem, uint numArcsProblem, const double lambdaValue, uint *solutionLow, uint *solutionHigh)
+static void readGraphSuper(hpf_context *ctx, const ArcInput *input)
 /*************************************************************************
-initializeContractedProblem - Setup problems for parametric cut
+readGraphSuper - Builds the super graph from an arc matrix or from separate
+arrays. The constant and multiplier arrays of the latter are used in place.
 *************************************************************************/
 {
-	uint i, newIndexTo, newIndexFrom;
-	uint currentNode = 2;
-    uint currentSourceSet = 0;
-    uint currentSinkSet = 0;
-    uint currentArc = 0;
-	int *nodeMap; /* indicator index of node in new nodeList. */
-
-	/* set cut parameters */
-	problem->cutValue = 0;
-
-	/* set solved indicator */
-	problem->solved = 0;
+	double *constantCapacity, *multiplierCapacity;
+	int i;
 
-	/* initialize optimal cut */
-	problem->optimalSourceSetIndicator = NULL;
+	ctx->arcListSuper = (Arc *)arenaAlloc(&ctx->scratch, ctx->numArcsSuper * sizeof(Arc));
 
-	/* initialize new lambda value */
-	problem->lambdaValue = lambdaValue;
-	/* set size of node sets */
-	problem->numSourceSet = 1;
-	problem->numSinkSet = 1;
-	problem->numNodesInList = 2;
+	/* Initialization */
+	for (i = 0; i < ctx->numArcsSuper; ++i)
+	{
+		initializeArc(&ctx->arcListSuper[i]);
+	}
 
-	/* allocateSpace for nodeMap */
-	if ((nodeMap = (int *)malloc(numNodesProblem* sizeof(int))) == NULL)
+	if (ctx->LAMBDA_LOW == ctx->LAMBDA_HIGH)
 	{
-		printf("Out of memory\n");
-		exit(0);
+		ctx->useParametricCut = 0;
 	}
 
-    for (i = 0; i < numNodesProblem; i++)
+	if (input->arcMatrix != NULL)
 	{
-		if (i == sourceSuper)
+		constantCapacity = (double *)arenaAlloc(&ctx->scratch, ctx->numArcsSuper * sizeof(double));
+		multiplierCapacity = (double *)arenaAlloc(&ctx->scratch, ctx->numArcsSuper * sizeof(double));
+
+		for (i = 0; i < ctx->numArcsSuper; ++i)
 		{
-			nodeMap[i] = 0;
+			ctx->arcListSuper[i].from = (uint) input->arcMatrix[i * 4 + 0];
+			ctx->arcListSuper[i].to = (uint) input->arcMatrix[i * 4 + 1];
+			constantCapacity[i] = input->arcMatrix[i * 4 + 2];
+			multiplierCapacity[i] = input->arcMatrix[i * 4 + 3];
 		}
-		else if (i == sinkSuper)
+
+		ctx->constantSuper = constantCapacity;
+		ctx->multiplierSuper = multiplierCapacity;
+		return;
+	}
+
+	if (input->from != NULL)
+	{
+		for (i = 0; i < ctx->numArcsSuper; ++i)
 		{
-			nodeMap[i] = 1;
+			ctx->arcListSuper[i].from = (uint) input->from[i];
+			ctx->arcListSuper[i].to = (uint) input->to[i];
 		}
-        else if (i != sourceSuper && solutionLow[i] == 1)
-        {   // Source set nodes
-			nodeMap[i] = 0;
-            problem->numSourceSet++;
-        }
-        else if (i != sinkSuper && solutionHigh[i] == 0)
-        {
-            // sink set nodes
-			nodeMap[i] = 1;
-            problem->numSinkSet++;
-        }
-        else
-        {
-            nodeMap[i] = currentNode;
-			++currentNode;
-            problem->numNodesInList++;
-        }
 	}
-
-	/* allocate space for the node sets*/
-	if ((problem->nodeList = (Node *)malloc(problem->numNodesInList * sizeof(Node))) == NULL)
+	else
 	{
-		printf("Out of memory\n");
-		exit(0);
+		for (i = 0; i < ctx->numArcsSuper; ++i)
+		{
+			ctx->arcListSuper[i].from = (uint) input->from64[i];
+			ctx->arcListSuper[i].to = (uint) input->to64[i];
+		}
 	}
-	if ((problem->sourceSet = (Node *)malloc(problem->numSourceSet * sizeof(Node))) == NULL)
+
+	ctx->constantSuper = input->constant;
+	if (input->multiplier != NULL)
 	{
-		printf("Out of memory\n");
-		exit(0);
+		ctx->multiplierSuper = input->multiplier;
 	}
-	if ((problem->sinkSet = (Node *)malloc(problem->numSinkSet * sizeof(Node))) == NULL)
+	else
 	{
-		printf("Out of memory\n");
-		exit(0);
+		/* non-parametric problem */
+		multiplierCapacity = (double *)arenaAlloc(&ctx->scratch, ctx->numArcsSuper * sizeof(double));
+		for (i = 0; i < ctx->numArcsSuper; ++i)
+		{
+			multiplierCapacity[i] = 0.0;
+		}
+		ctx->multiplierSuper = multiplierCapacity;
 	}
+}
 
-    // initialize nodes
-    for (i = 0; i < problem->numNodesInList; i++)
-    {
-        initializeNode(&problem->nodeList[i], i);
-    }
-    for (i = 0; i < problem->numSourceSet; i++)
-    {
-        initializeNode(&problem->sourceSet[i], i);
-    }
-    for (i = 0; i < problem->numSinkSet; i++)
-    {
-        initializeNode(&problem->sinkSet[i], i);
-    }
+static void checkIntegralCapacities(hpf_context *ctx)
+/*************************************************************************
+checkIntegralCapacities - Sets integralCapacities if all constants and
+multipliers of the super graph are integers whose absolute values add up
+to less than the integers that a double represents exactly
+*************************************************************************/
+{
+	uint i;
 
-     /* source is always first node */
-    problem->nodeList[0].originalIndex = -1; /* indicate artificial source node */
-    problem->nodeList[1].originalIndex = -2; /* indicate artificial sink node */
+	ctx->integralCapacities = 0;
+	ctx->constantSum = 0;
+	ctx->multiplierSum = 0;
+	if (!ctx->exactCapacities)
+	{
+		return;
+	}
 
-	/* create new node sets*/
-	for (i = 0; i < numNodesProblem; i++)
+	for (i = 0; i < ctx->numArcsSuper; ++i)
 	{
-		if (nodeMap[i] == 0)
+		if (!isIntegral(ctx->constantSuper[i]) || !isIntegral(ctx->multiplierSuper[i]))
 		{
-			problem->sourceSet[currentSourceSet].originalIndex = nodeListProblem[i].originalIndex;
-			currentSourceSet++;
+			return;
 		}
-		else if (nodeMap[i] == 1)
+		ctx->constantSum += dabs(ctx->constantSuper[i]);
+		ctx->multiplierSum += dabs(ctx->multiplierSuper[i]);
+	}
+
+	/* the constant and multiplier sums of computeIntersect are doubles */
+	ctx->integralCapacities = (ctx->constantSum + ctx->multiplierSum < 9007199254740992.0);
+}
+
+static __inline uint isFixedSource(hpf_context *ctx, uint i)
+{
+/*************************************************************************
+isFixedSource - Node i of the super graph is the source or fixed in the
+source set
+*************************************************************************/
+	return (i == ctx->sourceSuper || getBit(ctx->fixedSourceSet, i));
+}
+
+static __inline uint isFixedSink(hpf_context *ctx, uint i)
+{
+/*************************************************************************
+isFixedSink - Node i of the super graph is the sink or fixed in the sink
+set
+*************************************************************************/
+	return (i == ctx->sinkSuper || getBit(ctx->fixedSinkSet, i));
+}
+
+static void reduceGraphSuper(hpf_context *ctx)
+/*************************************************************************
+reduceGraphSuper - Shrinks the super graph before the parametric search.
+A node is fixed in the source set if, over the whole lambda range, its arcs
+from the source set have more capacity than all its other outgoing arcs,
+since every cut with the node in the sink set is then larger than the cut
+with the node moved to the source set. Nodes are fixed in the sink set in
+the same way. Fixing a node changes the bounds of its neighbors, which are
+checked again. The fixed nodes are contracted by the first problems, so
+only arcs from the source set to free nodes, from free nodes to the sink
+set and between free nodes are kept. Parallel arcs are merged if both are
+nonnegative over the whole range, so that rounding does not change their
+sum, and arcs with zero constant and multiplier are removed.
+*************************************************************************/
+{
+	uint n = ctx->numNodesSuper, m = ctx->numArcsSuper;
+	uint i, k, u, v, w, head = 0, numQueued = 0, numKept = 0;
+	uint *outStart, *inStart, *outArcs, *inArcs, *queue, *lastFrom, *lastArc, *mergedInto;
+	double *lowCap, *highCap, *sourceLow, *outHigh, *sinkLow, *inHigh;
+	double *constant, *multiplier;
+	ullint *isQueued;
+	Arc *arcs;
+	ArenaMark mark;
+
+	ctx->fixedSourceSet = (ullint *)arenaAlloc(&ctx->scratch, ctx->numWordsSuper * sizeof(ullint));
+	ctx->fixedSinkSet = (ullint *)arenaAlloc(&ctx->scratch, ctx->numWordsSuper * sizeof(ullint));
+	memset(ctx->fixedSourceSet, 0, ctx->numWordsSuper * sizeof(ullint));
+	memset(ctx->fixedSinkSet, 0, ctx->numWordsSuper * sizeof(ullint));
+	arcs = (Arc *)arenaAlloc(&ctx->scratch, (m + 1) * sizeof(Arc));
+	constant = (double *)arenaAlloc(&ctx->scratch, (m + 1) * sizeof(double));
+	multiplier = (double *)arenaAlloc(&ctx->scratch, (m + 1) * sizeof(double));
+
+	mark = arenaMark(&ctx->scratch);
+	lowCap = (double *)arenaAlloc(&ctx->scratch, (m + 1) * sizeof(double));
+	highCap = (double *)arenaAlloc(&ctx->scratch, (m + 1) * sizeof(double));
+
+	/* least and most capacity over the range, before rounding */
+	for (i = 0; i < m; ++i)
+	{
+		lowCap[i] = ctx->constantSuper[i] + ctx->multiplierSuper[i] * ctx->LAMBDA_LOW;
+		highCap[i] = ctx->constantSuper[i] + ctx->multiplierSuper[i] * ctx->LAMBDA_HIGH;
+		if (lowCap[i] > highCap[i])
 		{
-			problem->sinkSet[currentSinkSet].originalIndex = nodeListProblem[i].originalIndex;
-			currentSinkSet++;
+			double temp = lowCap[i];
+			lowCap[i] = highCap[i];
+			highCap[i] = temp;
 		}
-		else
+		if (lowCap[i] < 0 && !ctx->roundNegativeCapacity)
 		{
-			problem->nodeList[nodeMap[i]].originalIndex = nodeListProblem[i].originalIndex;
+			/* leave the graph as given, so that the solve reports the
+			   negative capacity */
+			arenaRewind(&ctx->scratch, mark);
+			ctx->fixedSourceSet = NULL;
+			ctx->fixedSinkSet = NULL;
+			return;
 		}
 	}
 
-    int *sourceAdjacentArcIndices, *sinkAdjacentArcIndices;
+	outStart = (uint *)arenaAlloc(&ctx->scratch, (n + 1) * sizeof(uint));
+	inStart = (uint *)arenaAlloc(&ctx->scratch, (n + 1) * sizeof(uint));
+	outArcs = (uint *)arenaAlloc(&ctx->scratch, (m + 1) * sizeof(uint));
+	inArcs = (uint *)arenaAlloc(&ctx->scratch, (m + 1) * sizeof(uint));
+	sourceLow = (double *)arenaAlloc(&ctx->scratch, n * sizeof(double));
+	outHigh = (double *)arenaAlloc(&ctx->scratch, n * sizeof(double));
+	sinkLow = (double *)arenaAlloc(&ctx->scratch, n * sizeof(double));
+	inHigh = (double *)arenaAlloc(&ctx->scratch, n * sizeof(double));
+	queue = (uint *)arenaAlloc(&ctx->scratch, n * sizeof(uint));
+	isQueued = (ullint *)arenaAlloc(&ctx->scratch, ctx->numWordsSuper * sizeof(ullint));
+	memset(outStart, 0, (n + 1) * sizeof(uint));
+	memset(inStart, 0, (n + 1) * sizeof(uint));
+	memset(isQueued, 0, ctx->numWordsSuper * sizeof(ullint));
+
+	/* the outgoing and incoming arcs of every node, without self loops */
+	for (i = 0; i < n; ++i)
+	{
+		sourceLow[i] = 0;
+		outHigh[i] = 0;
+		sinkLow[i] = 0;
+		inHigh[i] = 0;
+	}
+	for (i = 0; i < m; ++i)
+	{
+		u = ctx->arcListSuper[i].from;
+		v = ctx->arcListSuper[i].to;
+		if (u == v)
+		{
+			continue;
+		}
+		++ outStart[u + 1];
+		++ inStart[v + 1];
 
-    /* allocate space for source and sink arc indices */
-	if ((sourceAdjacentArcIndices = (int *)malloc(problem->numNodesInList *  sizeof(int))) == NULL)
+		if (u == ctx->sourceSuper)
+		{
+			sourceLow[v] += math_max(lowCap[i], 0);
+		}
+		else if (v != ctx->sourceSuper)
+		{
+			outHigh[u] += math_max(highCap[i], 0);
+		}
+		if (v == ctx->sinkSuper)
+		{
+			sinkLow[u] += math_max(lowCap[i], 0);
+		}
+		else if (u != ctx->sinkSuper)
+		{
+			inHigh[v] += math_max(highCap[i], 0);
+		}
+	}
+	for (i = 0; i < n; ++i)
 	{
-		printf("Out of memory\n");
-		exit(0);
+		outStart[i+1] += outStart[i];
+		inStart[i+1] += inStart[i];
 	}
-	if ((sinkAdjacentArcIndices = (int *)malloc(problem->numNodesInList *sizeof(int))) == NULL )
+	for (i = 0; i < m; ++i)
 	{
-		printf("Out of memory\n");
-		exit(0);
+		u = ctx->arcListSuper[i].from;
+		v = ctx->arcListSuper[i].to;
+		if (u != v)
+		{
+			outArcs[outStart[u]++] = i;
+			inArcs[inStart[v]++] = i;
+		}
+	}
+	for (i = n; i > 0; --i)
+	{
+		outStart[i] = outStart[i-1];
+		inStart[i] = inStart[i-1];
 	}
+	outStart[0] = 0;
+	inStart[0] = 0;
 
-	/* initialize indices */
-	for (i = 0; i < problem->numNodesInList; i++)
+	for (i = 0; i < n; ++i)
 	{
-		sourceAdjacentArcIndices[i] = -1;
-		sinkAdjacentArcIndices[i] = -1;
+		if (i != ctx->sourceSuper && i != ctx->sinkSuper)
+		{
+			queue[numQueued++] = i;
+			setBit(isQueued, i);
+		}
 	}
 
-	/* determine new number of arcs */
-	for (i = 0; i < numArcsProblem; i++)
+	while (numQueued > 0)
 	{
-		newIndexFrom = nodeMap[arcListProblem[i].from->number];
-		newIndexTo = nodeMap[arcListProblem[i].to->number];
+		v = queue[head];
+		head = (head + 1) % n;
+		-- numQueued;
+		isQueued[v / WORD_BITS] &= ~(1ULL << (v % WORD_BITS));
 
-		if (newIndexFrom == newIndexTo || newIndexTo==0 || newIndexFrom==1 || (newIndexFrom == 0 && newIndexTo == 1))
+		if (sourceLow[v] - outHigh[v] > TOL)
 		{
+			/* arcs from v now start in the source set, and arcs into v
+			   end there and are never cut */
+			setBit(ctx->fixedSourceSet, v);
+			for (k = outStart[v]; k < outStart[v+1]; ++k)
+			{
+				w = ctx->arcListSuper[outArcs[k]].to;
+				sourceLow[w] += math_max(lowCap[outArcs[k]], 0);
+			}
+			for (k = inStart[v]; k < inStart[v+1]; ++k)
+			{
+				w = ctx->arcListSuper[inArcs[k]].from;
+				outHigh[w] -= math_max(highCap[inArcs[k]], 0);
+			}
 		}
-		else if (newIndexFrom == 0)
+		else if (sinkLow[v] - inHigh[v] > TOL)
 		{
-			if (sourceAdjacentArcIndices[newIndexTo] == -1)
+			setBit(ctx->fixedSinkSet, v);
+			for (k = inStart[v]; k < inStart[v+1]; ++k)
 			{
-				sourceAdjacentArcIndices[newIndexTo] = currentArc;
-				++currentArc;
+				w = ctx->arcListSuper[inArcs[k]].from;
+				sinkLow[w] += math_max(lowCap[inArcs[k]], 0);
+			}
+			for (k = outStart[v]; k < outStart[v+1]; ++k)
+			{
+				w = ctx->arcListSuper[outArcs[k]].to;
+				inHigh[w] -= math_max(highCap[outArcs[k]], 0);
 			}
 		}
-		else if (newIndexTo == 1)
+		else
 		{
-			if (sinkAdjacentArcIndices[newIndexFrom] == -1)
+			continue;
+		}
+
+		++ ctx->numFixedNodes;
+		for (k = outStart[v]; k < outStart[v+1]; ++k)
+		{
+			w = ctx->arcListSuper[outArcs[k]].to;
+			if (!isFixedSource(ctx, w) && !isFixedSink(ctx, w) && !getBit(isQueued, w))
 			{
-				sinkAdjacentArcIndices[newIndexFrom] = currentArc;
-				++currentArc;
+				queue[(head + numQueued++) % n] = w;
+				setBit(isQueued, w);
 			}
 		}
-		else
+		for (k = inStart[v]; k < inStart[v+1]; ++k)
 		{
-			++currentArc;
+			w = ctx->arcListSuper[inArcs[k]].from;
+			if (!isFixedSource(ctx, w) && !isFixedSink(ctx, w) && !getBit(isQueued, w))
+			{
+				queue[(head + numQueued++) % n] = w;
+				setBit(isQueued, w);
+			}
 		}
 	}
 
-	/* set number of arcs */
-	problem->numArcs = currentArc;
-
-	/* allocate space for arcs */
-	if ((problem->arcList = (Arc *)malloc(problem->numArcs * sizeof(Arc))) == NULL)
+	/* arcs that stay in some contracted problem, in the order of the
+	   outgoing arcs of every node. An arc is merged into the last kept arc
+	   with the same ends. */
+	lastFrom = (uint *)arenaAlloc(&ctx->scratch, n * sizeof(uint));
+	lastArc = (uint *)arenaAlloc(&ctx->scratch, n * sizeof(uint));
+	mergedInto = (uint *)arenaAlloc(&ctx->scratch, (m + 1) * sizeof(uint));
+	for (i = 0; i < n; ++i)
 	{
-		printf("Out of memory\n");
-		exit(0);
+		lastFrom[i] = n;
 	}
-
-	/* copy arcs */
-	currentArc = 0;
-	for (i = 0; i < numArcsProblem; i++)
+	for (i = 0; i < m; ++i)
 	{
-		newIndexFrom = nodeMap[arcListProblem[i].from->number];
-		newIndexTo = nodeMap[arcListProblem[i].to->number];
-
-		if (newIndexFrom == newIndexTo || newIndexTo==0 || newIndexFrom==1 ||  (newIndexFrom == 0 && newIndexTo == 1))
+		mergedInto[i] = m;
+	}
+	for (u = 0; u < n; ++u)
+	{
+		if (isFixedSink(ctx, u))
 		{
+			continue;
 		}
-		else if (newIndexFrom == 0)
+		for (k = outStart[u]; k < outStart[u+1]; ++k)
 		{
-			if (sourceAdjacentArcIndices[newIndexTo] == currentArc )
+			i = outArcs[k];
+			v = ctx->arcListSuper[i].to;
+			if (isFixedSource(ctx, v) || (isFixedSource(ctx, u) && isFixedSink(ctx, v)) || (ctx->constantSuper[i] == 0 && ctx->multiplierSuper[i] == 0))
 			{
-				copyArcNew(problem, nodeMap, &arcListProblem[i], &problem->arcList[currentArc], lambdaValue);
-				++currentArc;
+				continue;
 			}
-			else
+			if (lastFrom[v] == u && lowCap[lastArc[v]] >= 0 && lowCap[i] >= 0)
 			{
-				copyArcAdd(&arcListProblem[i], &problem->arcList[sourceAdjacentArcIndices[newIndexTo]], lambdaValue);
+				mergedInto[i] = lastArc[v];
+				continue;
 			}
+			lastFrom[v] = u;
+			lastArc[v] = i;
+			mergedInto[i] = i;
 		}
-		else if (newIndexTo == 1)
+	}
+
+	/* the kept arcs in their original order, mergedInto is reused for
+	   their new numbers */
+	for (i = 0; i < m; ++i)
+	{
+		if (mergedInto[i] == i)
 		{
-			if (sinkAdjacentArcIndices[newIndexFrom] == currentArc)
-			{
-				copyArcNew(problem, nodeMap, &arcListProblem[i], &problem->arcList[currentArc], lambdaValue);
-				++currentArc;
-			}
-			else
-			{
-				copyArcAdd(&arcListProblem[i], &problem->arcList[sinkAdjacentArcIndices[newIndexFrom]], lambdaValue);
-			}
+			initializeArc(&arcs[numKept]);
+			arcs[numKept].from = ctx->arcListSuper[i].from;
+			arcs[numKept].to = ctx->arcListSuper[i].to;
+			constant[numKept] = ctx->constantSuper[i];
+			multiplier[numKept] = ctx->multiplierSuper[i];
+			mergedInto[i] = numKept++;
 		}
-		else
+		else if (mergedInto[i] < m)
 		{
-			copyArcNew(problem, nodeMap, &arcListProblem[i], &problem->arcList[currentArc], lambdaValue);
-			++currentArc;
+			constant[mergedInto[mergedInto[i]]] += ctx->constantSuper[i];
+			multiplier[mergedInto[mergedInto[i]]] += ctx->multiplierSuper[i];
 		}
 	}
 
-    /* free nodeMap*/
-	free(nodeMap);
-	nodeMap = NULL;
-    free(sourceAdjacentArcIndices);
-    sourceAdjacentArcIndices = NULL;
-    free(sinkAdjacentArcIndices);
-    sinkAdjacentArcIndices = NULL;
+	ctx->numRemovedArcs = m - numKept;
+	ctx->numArcsSuper = numKept;
+	ctx->arcListSuper = arcs;
+	ctx->constantSuper = constant;
+	ctx->multiplierSuper = multiplier;
+
+	arenaRewind(&ctx->scratch, mark);
 }
 
-static void initializeParametricCut(CutProblem *lowProblem, CutProblem *highProblem)
+static void globalUpdate (hpf_context *ctx)
+{
 /*************************************************************************
-initializeParametricCut - Set up data structures for parametric cut
+globalUpdate - Raises all labels to the distances to the nodes of label 0,
+which include the roots of all weak trees, found by a breadth first search
+backwards along the out of tree and tree arcs. A parent is at most as far
+as its children, so the labels still do not decrease from a root to its
+leaves. Strong trees that reach no node of label 0 are lifted as after a
+gap, the other strong roots are put into the buckets of their new labels.
 *************************************************************************/
-{
-    uint *all_source, *all_sink;
-	// disable contraction by passing dummy low/high problem solutions.
-    if ((all_sink = (uint *)malloc(numNodesSuper *  sizeof(uint))) == NULL)
-	{
-		printf("Out of memory\n");
-		exit(0);
-	}
-	if ((all_source = (uint *)malloc(numNodesSuper  *sizeof(uint))) == NULL )
+	uint n = ctx->numNodes;
+	uint numRoots = 0, numQueued = 0, head = 0, tail = 0;
+	uint queueSize = 2 * n + 1;
+	uint numWords = n / WORD_BITS + 1;
+	uint i, j, k, e, other, label, highest = 1;
+	uint *distance, *roots, *queue, *inStart, *inNodes;
+	ullint *isSettled;
+	Node *node, *child;
+	Arc *arc;
+	ArenaMark mark = arenaMark(&ctx->scratch);
+
+	++ ctx->numGlobalUpdates;
+
+	distance = (uint *)arenaAlloc(&ctx->scratch, n * sizeof(uint));
+	roots = (uint *)arenaAlloc(&ctx->scratch, n * sizeof(uint));
+	queue = (uint *)arenaAlloc(&ctx->scratch, queueSize * sizeof(uint));
+	inStart = (uint *)arenaAlloc(&ctx->scratch, (n + 1) * sizeof(uint));
+	isSettled = (ullint *)arenaAlloc(&ctx->scratch, numWords * sizeof(ullint));
+	memset(isSettled, 0, numWords * sizeof(ullint));
+
+	/* the strong roots leave their buckets until their labels are known */
+	for (label=0; label<n; ++label)
 	{
-		printf("Out of memory\n");
-		exit(0);
+		for (node = ctx->strongRoots[label].start; (node); node = node->next)
+		{
+			roots[numRoots++] = (uint) (node - ctx->nodesList);
+		}
+		initializeRoot (&ctx->strongRoots[label]);
 	}
-    for (uint i = 0; i < numNodesSuper; i++)
-    {
-        all_sink[i] = 0;
-        all_source[i] = 1;
-    }
-
-    /* initialize problem for LAMBDA_LOW */
-    initializeContractedProblem(lowProblem, nodeListSuper, numNodesSuper, arcListSuper, numArcsSuper,LAMBDA_LOW, all_sink, all_source);
+	memset(ctx->activeLabels, 0, numWords * sizeof(ullint));
+	memset(ctx->activeLabelWords, 0, (numWords / WORD_BITS + 1) * sizeof(ullint));
 
-	if (useParametricCut == 1)
+	/* the nodes with an out of tree arc to each node */
+	memset(inStart, 0, (n + 1) * sizeof(uint));
+	for (i=0; i<n; ++i)
 	{
-		/* initialize problem for LAMBDA_HIGH */
-		initializeContractedProblem(highProblem, nodeListSuper, numNodesSuper, arcListSuper, numArcsSuper,LAMBDA_HIGH, all_sink, all_source);
+		node = &ctx->nodesList[i];
+		distance[i] = (uint) -1;
+		if (i == ctx->source || i == ctx->sink || node->label >= n)
+		{
+			continue;
+		}
+		for (j=0; j<node->numOutOfTree; ++j)
+		{
+			arc = &ctx->arcList[ctx->outOfTreeArcs[ctx->outOfTreeStart[i] + j]];
+			other = (arc->from == i) ? arc->to : arc->from;
+			++ inStart[other + 1];
+		}
 	}
-
-    free(all_sink);
-    free(all_source);
-}
-
-static void addBreakpoint(double lambdaValue, uint *sourceSetIndicator)
-/*************************************************************************
-addBreakpoint - Adds a breakpoint to the linkedlist
-*************************************************************************/
-{
-	Breakpoint *newBreakpoint;
-	uint i;
-
-    // printf("New breakpoint: %lf\n", lambdaValue);
-
-	/* allocate memory for breakpoint*/
-	if ((newBreakpoint= (Breakpoint*)malloc(sizeof(Breakpoint))) == NULL)
+	for (i=0; i<n; ++i)
 	{
-		printf("Could not allocate memory.\n");
-		exit(0);
+		inStart[i+1] += inStart[i];
 	}
-
-	/* assign values */
-	newBreakpoint->lambdaValue = lambdaValue;
-	newBreakpoint->next = NULL;
-
-	/* assign space for cut */
-	if ((newBreakpoint->sourceSetIndicator = (uint*)malloc(numNodesSuper * sizeof(uint))) == NULL)
+	inNodes = (uint *)arenaAlloc(&ctx->scratch, (inStart[n] + 1) * sizeof(uint));
+	for (i=0; i<n; ++i)
 	{
-		printf("Could not allocate memory.\n");
-		exit(0);
+		node = &ctx->nodesList[i];
+		if (i == ctx->source || i == ctx->sink || node->label >= n)
+		{
+			continue;
+		}
+		for (j=0; j<node->numOutOfTree; ++j)
+		{
+			arc = &ctx->arcList[ctx->outOfTreeArcs[ctx->outOfTreeStart[i] + j]];
+			other = (arc->from == i) ? arc->to : arc->from;
+			inNodes[inStart[other]++] = i;
+		}
 	}
-
-	/* copy cut */
-	for (i = 0; i < numNodesSuper; i++)
+	for (i=n; i>0; --i)
 	{
-		newBreakpoint->sourceSetIndicator[i] = sourceSetIndicator[i];
+		inStart[i] = inStart[i-1];
 	}
+	inStart[0] = 0;
 
-	/* add breakpoint to linkedlist */
-	if (lastBreakpoint == NULL)
+	/* the search starts from all nodes of label 0, the weak roots among
+	   them. Arcs of cost 0 go to the front of the queue. */
+	for (i=0; i<n; ++i)
 	{
-		/* initialize list */
-		firstBreakpoint = newBreakpoint;
-		lastBreakpoint = newBreakpoint;
-	}
-	else
-	{
-		/* add new element to linked list*/
-		lastBreakpoint->next = newBreakpoint;
-		/* update head */
-		lastBreakpoint = newBreakpoint;
+		if (i != ctx->source && i != ctx->sink && ctx->nodesList[i].label == 0)
+		{
+			distance[i] = 0;
+			queue[tail++] = i;
+			++ numQueued;
+		}
 	}
-}
-
-static void createMemoryStructures( )
-/*************************************************************************
-createMemoryStructures - creates memory structures
-*************************************************************************/
-{
-	uint from;
-	uint to;
-	uint i;
-	double capacity;
 
-	/* create memory structures */
-	for (i=0; i<numNodes; ++i)
+	while (numQueued > 0)
 	{
-		createOutOfTree(&nodesList[i]);
-	}
+		i = queue[head];
+		head = (head + 1) % queueSize;
+		-- numQueued;
+		if (getBit(isSettled, i))
+		{
+			continue;
+		}
+		setBit(isSettled, i);
+		k = distance[i];
 
-	for (i=0; i<numArcs; i++)
-	{
-		to = arcList[i].to->number;
-		from = arcList[i].from->number;
-		capacity = arcList[i].capacity;
+		for (e=inStart[i]; e<inStart[i+1]; ++e)
+		{
+			if (k + 1 < distance[inNodes[e]])
+			{
+				distance[inNodes[e]] = k + 1;
+				queue[tail] = inNodes[e];
+				tail = (tail + 1) % queueSize;
+				++ numQueued;
+			}
+		}
 
-		if (!((source == to) || (sink == from) || (from == to)))
+		node = &ctx->nodesList[i];
+		if (node->parent && k < distance[node->parent - ctx->nodesList])
+		{
+			distance[node->parent - ctx->nodesList] = k;
+			head = (head + queueSize - 1) % queueSize;
+			queue[head] = (uint) (node->parent - ctx->nodesList);
+			++ numQueued;
+		}
+		for (child = node->childList; (child); child = child->next)
 		{
-			if ((source == from) && (to == sink))
+			if (k + 1 < distance[child - ctx->nodesList])
 			{
-				arcList[i].flow = capacity;
-			} else if (to == sink) {
-				addOutOfTreeNode(&nodesList[to], &arcList[i]);
-			} else {
-				addOutOfTreeNode(&nodesList[from], &arcList[i]);
+				distance[child - ctx->nodesList] = k + 1;
+				queue[tail] = (uint) (child - ctx->nodesList);
+				tail = (tail + 1) % queueSize;
+				++ numQueued;
 			}
 		}
 	}
 
-	/* allocate memory for root and label count */
-	if ((strongRoots = (Root *)malloc(numNodes * sizeof(Root))) == NULL)
-	{
-		printf("Could not allocate memory.\n");
-		exit(0);
-	}
-	if ((labelCount = (uint *)malloc(numNodes * sizeof(uint))) == NULL)
+	/* labels are lower bounds of the distances, so they only increase */
+	for (i=0; i<n; ++i)
 	{
-		printf("Could not allocate memory.\n");
-		exit(0);
+		node = &ctx->nodesList[i];
+		if (getBit(isSettled, i) && distance[i] > node->label)
+		{
+			-- ctx->labelCount[node->label];
+			node->label = distance[i];
+			++ ctx->labelCount[node->label];
+			node->nextArc = 0;
+		}
 	}
 
-	/* Initialization of root & labelcount */
-	for (i = 0; i<numNodes; ++i)
+	for (i=0; i<numRoots; ++i)
 	{
-		initializeRoot(&strongRoots[i]);
-		labelCount[i] = 0;
+		node = &ctx->nodesList[roots[i]];
+		if (!getBit(isSettled, roots[i]))
+		{
+			liftAll (ctx, node);
+			continue;
+		}
+
+		addToStrongBucket (ctx, node, node->label);
+		if (node->label > highest)
+		{
+			highest = node->label;
+		}
 	}
+	ctx->highestStrongLabel = highest;
+
+	arenaRewind(&ctx->scratch, mark);
 }
 
-static void evaluateCut(CutProblem *problem)
+static void pseudoflowPhase1 (hpf_context *ctx)
+{
 /*************************************************************************
-evaluateCut - Evaluates optimal cut parameters for a given problem
+pseudoflowPhase1 - Processes the highest strong root until there is none.
+If global updates are on, the labels are recomputed whenever the arc scans
+and relabels since the last update reach globalUpdate times the size of
+the problem.
 *************************************************************************/
-{
-	uint i;
-	int originalIndexFrom;
-	int originalIndexTo;
-	for (i = 0; i < problem->numArcs; ++i)
+	Node *strongRoot;
+	ullint scans = ctx->numArcScans, relabels = ctx->numRelabels;
+	ullint interval = (ullint) ctx->globalUpdate * (ctx->numNodes + ctx->numArcs);
+
+	while ((strongRoot = getHighestStrongRoot (ctx)))
 	{
-		originalIndexFrom = problem->arcList[i].from->originalIndex;
-		originalIndexTo = problem->arcList[i].to->originalIndex;
-		if ((originalIndexFrom == -1 || problem->optimalSourceSetIndicator[originalIndexFrom] == 1) && (originalIndexTo == -2 || problem->optimalSourceSetIndicator[originalIndexTo] == 0 ) )
+		processRoot (ctx, strongRoot);
+
+		if (interval > 0 && (ctx->numArcScans - scans) + (ctx->numRelabels - relabels) >= interval)
 		{
-		  problem->cutValue += problem->arcList[i].capacity;
+			globalUpdate (ctx);
+			scans = ctx->numArcScans;
+			relabels = ctx->numRelabels;
 		}
 	}
 }
 
-static void solveProblem(CutProblem *problem, uint maximalSourceSet)
-/*************************************************************************
-solveProblem - solves a single instance of cut problem
-*************************************************************************/
+#ifndef HPF_NO_THREADS
+typedef struct RegionTask
 {
-	uint i;
-	uint *tempSourceSet;
-	uint nodeCount;
-
-	nodesList = problem->nodeList;
-	numNodes = problem->numNodesInList;
-	numArcs = problem->numArcs;
-	problem->cutValue = 0.0;
-
-    // reset some globals
-    highestStrongLabel = 1;
-	lowestPositiveExcessNode = 0;
+	hpf_context *ctx;
+	uint begin;
+	uint end;
+	uint *numHidden;
+} RegionTask;
 
+static void hideRegionArcs (hpf_context *ctx, uint begin, uint end, uint *numHidden)
+{
+/*************************************************************************
+hideRegionArcs - Moves the out of tree arcs of nodes begin .. end - 1 that
+leave the region to the end of their slots, where findWeakNode does not see
+them
+*************************************************************************/
+	uint i, j, other, last, slotSize;
+	uint *outOfTree;
+	Node *node;
+	Arc *arc;
 
-	// handle empty problems
-	if (numNodes == 2)
+	for (i=begin; i<end; ++i)
 	{
-		/* assign nodes to source / sink set */
-		if ((problem->optimalSourceSetIndicator = (uint *)malloc(numNodesSuper * sizeof(uint))) == NULL)
-		{
-			printf("Out of memory\n");
-			exit(0);
-		}
+		node = &ctx->nodesList[i];
+		outOfTree = &ctx->outOfTreeArcs[ctx->outOfTreeStart[i]];
+		slotSize = ctx->outOfTreeStart[i+1] - ctx->outOfTreeStart[i];
+		numHidden[i] = 0;
 
-		for (i = 0; i < problem->numSourceSet; i++)
-		{
-			problem->optimalSourceSetIndicator[problem->sourceSet[i].originalIndex] = 1;
-		}
-
-		for (i = 0; i < problem->numSinkSet; i++)
-		{
-			problem->optimalSourceSetIndicator[problem->sinkSet[i].originalIndex] = 0;
-		}
-
-		/* determine cut value */
-		for (i = 0; i < problem->numArcs; i++)
+		for (j=0; j<node->numOutOfTree; )
 		{
-			if (problem->arcList[i].from->originalIndex == -1 && problem->arcList[i].to->originalIndex == -2)
+			arc = &ctx->arcList[outOfTree[j]];
+			other = (arc->from == i) ? arc->to : arc->from;
+			if (other >= begin && other < end)
 			{
-				problem->cutValue += problem->arcList[i].capacity;
+				++ j;
+				continue;
 			}
-		}
 
-        problem->solved =1;
-		return;
+			last = outOfTree[node->numOutOfTree - 1];
+			-- node->numOutOfTree;
+			outOfTree[slotSize - numHidden[i] - 1] = outOfTree[j];
+			outOfTree[j] = last;
+			++ numHidden[i];
+		}
 	}
+}
 
+static void restoreRegionArcs (hpf_context *ctx, uint begin, uint end, uint *numHidden)
+{
+/*************************************************************************
+restoreRegionArcs - Appends the arcs moved by hideRegionArcs to the out of
+tree arcs again. A node never has more out of tree and hidden arcs than
+adjacent arcs, so the two ranges of a slot do not overlap during the
+region phase.
+*************************************************************************/
+	uint i, k, slotSize;
+	uint *outOfTree;
+	Node *node;
 
-	if (maximalSourceSet == 1)
+	for (i=begin; i<end; ++i)
 	{
-		source = 1;
-		sink = 0;
+		node = &ctx->nodesList[i];
+		outOfTree = &ctx->outOfTreeArcs[ctx->outOfTreeStart[i]];
+		slotSize = ctx->outOfTreeStart[i+1] - ctx->outOfTreeStart[i];
 
-		/* allocate space for reversed arcs */
-		if ((arcList = (Arc *)malloc(numArcs * sizeof(Arc))) == NULL)
+		for (k=0; k<numHidden[i]; ++k)
 		{
-			printf("Out of memory\n");
-			exit(0);
+			outOfTree[node->numOutOfTree + k] = outOfTree[slotSize - numHidden[i] + k];
 		}
+		node->numOutOfTree += numHidden[i];
+		node->nextArc = 0;
+	}
+}
 
-		/* copy arcs such that arcs can be reversed */
-		for (i = 0; i < numArcs; i++)
-		{
-			/* initialize new arc*/
-			initializeArc(&arcList[i]);
+static void * solveRegion (void *arg)
+{
+/*************************************************************************
+solveRegion - Runs phase 1 on the arcs between nodes begin .. end - 1 of a
+region task. Labels only refer to the arcs of the region, so afterwards the
+nodes are labeled as after simpleInitialization: 0 for roots without
+excess and 1 for all other nodes. Labels then differ by at most one and do
+not decrease from a root to the leaves of its tree.
+*************************************************************************/
+	RegionTask *task = (RegionTask *)arg;
+	hpf_context *ctx = task->ctx;
+	uint i;
 
-			// reverse direction
-			arcList[i].from = problem->arcList[i].to;
-			arcList[i].to = problem->arcList[i].from;
+	hideRegionArcs (ctx, task->begin, task->end, task->numHidden);
+	pseudoflowPhase1 (ctx);
+	restoreRegionArcs (ctx, task->begin, task->end, task->numHidden);
 
-			// assign capacity
-			arcList[i].capacity = problem->arcList[i].capacity;
-		}
-	}
-	else
+	for (i=task->begin; i<task->end; ++i)
 	{
-		source = 0;
-		sink = 1;
-
-		arcList = problem->arcList;
+		if ((ctx->nodesList[i].parent == NULL) && (isExcess(ctx->nodesList[i].excess) <= 0))
+		{
+			ctx->nodesList[i].label = 0;
+		}
+		else
+		{
+			ctx->nodesList[i].label = 1;
+		}
 	}
 
-	// solve
-	createMemoryStructures();
-	simpleInitialization();
-	pseudoflowPhase1();
+	return NULL;
+}
+#endif
 
-	/* allocate memory for source set (possibly reversed) */
-	nodeCount = problem->numNodesInList + problem->numSourceSet + problem->numSinkSet - 2;
-	if ((tempSourceSet = (uint *)malloc(nodeCount * sizeof(uint))) == NULL)
+static void pseudoflowRegions (hpf_context *ctx)
+{
+/*************************************************************************
+pseudoflowRegions - Splits the nodes other than the source and sink into
+numRegionThreads ranges of consecutive nodes and runs phase 1 on every
+range in its own thread, before phase 1 runs on the whole graph. Regions
+share no nodes and only merge along arcs inside the region, so the threads
+touch disjoint parts of the graph. The result is a normalized pseudoflow
+with valid labels that phase 1 continues from, so the cut does not depend
+on the number of regions.
+*************************************************************************/
+#ifndef HPF_NO_THREADS
+	uint numRegions = ctx->numRegionThreads;
+	uint numRegionNodes, r, i;
+	uint *numHidden;
+	hpf_context *workers;
+	RegionTask *tasks;
+	pthread_t *threads;
+	int *started;
+
+	if (numRegions < 2 || ctx->numNodes < REGION_MIN_NODES || ctx->numNodes - 2 < numRegions)
 	{
-		printf("Out of memory\n");
-		exit(0);
+		return;
 	}
 
-	// retrieve optimal sourceSet for nodes in graph
-	if (maximalSourceSet == 1) // reverse assignment to source and sink set
+	workers = (hpf_context *)arenaAlloc(&ctx->scratch, numRegions * sizeof(hpf_context));
+	tasks = (RegionTask *)arenaAlloc(&ctx->scratch, numRegions * sizeof(RegionTask));
+	threads = (pthread_t *)arenaAlloc(&ctx->scratch, numRegions * sizeof(pthread_t));
+	started = (int *)arenaAlloc(&ctx->scratch, numRegions * sizeof(int));
+	numHidden = (uint *)arenaAlloc(&ctx->scratch, ctx->numNodes * sizeof(uint));
+
+	/* the strong roots are assigned to the regions below */
+	initializeRoot (&ctx->strongRoots[1]);
+	clearActiveLabel (ctx, 1);
+
+	// nodes 0 and 1 are the source and sink of every subproblem
+	for (r=0; r<numRegions; ++r)
 	{
-		for (i = 2; i<numNodes; ++i) // start from 2 to ignore artificial source and sink
+		tasks[r].ctx = &workers[r];
+		tasks[r].begin = 2 + (uint) (((ullint) (ctx->numNodes - 2) * r) / numRegions);
+		tasks[r].end = 2 + (uint) (((ullint) (ctx->numNodes - 2) * (r + 1)) / numRegions);
+		tasks[r].numHidden = numHidden;
+
+		/* the labels of a region are at most its number of nodes, lifted
+		   nodes get the label numRegionNodes + 2 */
+		numRegionNodes = tasks[r].end - tasks[r].begin;
+		workers[r] = *ctx;
+		workers[r].numNodes = numRegionNodes + 2;
+		workers[r].strongRoots = (Root *)arenaAlloc(&ctx->scratch, (numRegionNodes + 3) * sizeof(Root));
+		workers[r].labelCount = (uint *)arenaAlloc(&ctx->scratch, (numRegionNodes + 3) * sizeof(uint));
+		createActiveLabels (&workers[r], &ctx->scratch, numRegionNodes + 3);
+		workers[r].highestStrongLabel = 1;
+		workers[r].numArcScans = 0;
+		workers[r].numPushes = 0;
+		workers[r].numMergers = 0;
+		workers[r].numRelabels = 0;
+		workers[r].numGaps = 0;
+		workers[r].numBucketScans = 0;
+		/* the labels of a region do not see the arcs that leave it */
+		workers[r].globalUpdate = 0;
+
+		for (i=0; i<numRegionNodes + 3; ++i)
 		{
-			if (nodesList[i].label >= numNodes)
-			{
-				tempSourceSet[nodesList[i].originalIndex] = 0;
-			}
-			else
-			{
-				tempSourceSet[nodesList[i].originalIndex] = 1;
-			}
+			initializeRoot (&workers[r].strongRoots[i]);
+			workers[r].labelCount[i] = 0;
 		}
-	}
-	else
-	{
-		for (i = 2; i<numNodes; ++i) // start from 2 to ignore artificial source and sink
+		for (i=tasks[r].begin; i<tasks[r].end; ++i)
 		{
-			if (nodesList[i].label >= numNodes)
-			{
-				tempSourceSet[nodesList[i].originalIndex] = 1;
-			}
-			else
+			if (isExcess(ctx->nodesList[i].excess) > 0)
 			{
-				tempSourceSet[nodesList[i].originalIndex] = 0;
+				++ workers[r].labelCount[1];
+				addToStrongBucket (&workers[r], &ctx->nodesList[i], 1);
 			}
 		}
+		workers[r].labelCount[0] = numRegionNodes - workers[r].labelCount[1];
 	}
 
-	// process cut for source set nodes
-	for (i = 0; i < problem->numSourceSet; i++)
+	for (r=1; r<numRegions; ++r)
 	{
-		tempSourceSet[problem->sourceSet[i].originalIndex] = 1;
+		started[r] = (pthread_create(&threads[r], NULL, solveRegion, &tasks[r]) == 0);
 	}
-	// process cut for sink set nodes
-	for (i = 0; i < problem->numSinkSet; i++)
+	solveRegion (&tasks[0]);
+	for (r=1; r<numRegions; ++r)
 	{
-		tempSourceSet[problem->sinkSet[i].originalIndex] = 0;
+		if (started[r])
+		{
+			pthread_join(threads[r], NULL);
+		}
+		else
+		{
+			/* could not start a thread: solve the region here */
+			solveRegion (&tasks[r]);
+		}
 	}
 
-	// assign cut
-	problem->optimalSourceSetIndicator = tempSourceSet;
-	evaluateCut(problem);
-
-	if (maximalSourceSet == 1)
+	for (r=0; r<numRegions; ++r)
 	{
-		// free if new memory has been allocated for arclist. Memory should not be freed if arcList is taken from the problem
-		free(arcList);
-		arcList = NULL;
+		ctx->numArcScans += workers[r].numArcScans;
+		ctx->numPushes += workers[r].numPushes;
+		ctx->numMergers += workers[r].numMergers;
+		ctx->numRelabels += workers[r].numRelabels;
+		ctx->numGaps += workers[r].numGaps;
+		ctx->numBucketScans += workers[r].numBucketScans;
 	}
 
-    problem->solved =1;
-
-	// printCutProblem(problem);
-	freeMemorySolve();
-}
-
-static void differenceSourceSets(uint **ppdifference, uint *lowOptimalSourceIndicator, uint *highOptimalSourceIndicator)
-{
-    if ((*ppdifference = (uint *)malloc(numNodesSuper * sizeof(uint))) == NULL)
+	/* restart from the initial labels */
+	ctx->labelCount[0] = 0;
+	ctx->labelCount[1] = 0;
+	for (i=2; i<ctx->numNodes; ++i)
 	{
-		printf("Out of memory\n");
-		exit(0);
+		++ ctx->labelCount[ctx->nodesList[i].label];
+		if ((ctx->nodesList[i].parent == NULL) && (isExcess(ctx->nodesList[i].excess) > 0))
+		{
+			addToStrongBucket (ctx, &ctx->nodesList[i], 1);
+		}
 	}
-    uint *pdifference = *ppdifference;
-    for (int i = 0; i < numNodesSuper; i++)
-    {
-        pdifference[i] = highOptimalSourceIndicator[i] - lowOptimalSourceIndicator[i];
-    }
+	ctx->highestStrongLabel = 1;
+#endif
 }
 
-static double internalCutCapacity(uint *optimalSourceSetIndicator) {
-    int from, to;
-    double arc_capacity;
-    double capacity = 0;
+static void packSourceSet(hpf_context *ctx, const ullint *sourceSetIndicator, unsigned int *row)
+/*************************************************************************
+packSourceSet - Copies a source set to a row of HPF_CUTS_PACKED
+*************************************************************************/
+{
+	int j;
 
-    for (int i=0; i < numArcsSuper; i++)
-    {
-        from = arcListSuper[i].from->originalIndex;
-        to = arcListSuper[i].to->originalIndex;
-        arc_capacity = arcListSuper[i].constant;
-        if (optimalSourceSetIndicator[from] == 1 && optimalSourceSetIndicator[to] == 0 && from != sourceSuper && to != sinkSuper) {
-            capacity += arc_capacity;
-        }
-    }
-    return capacity;
+	for (j = 0; j < HPF_CUT_WORDS((int) ctx->numNodesSuper); j++)
+	{
+		row[j] = (unsigned int) (0xFFFFFFFFULL & (sourceSetIndicator[j / 2] >> (32 * (j % 2))));
+	}
 }
 
-static double computeIntersect(uint *difference, double K12)
+static void unpackSourceSet(hpf_context *ctx, const unsigned int *row, CutProblem *problem)
+/*************************************************************************
+unpackSourceSet - Makes a row of HPF_CUTS_PACKED the optimal source set of
+a problem that is not solved, with the source in and the sink out of it
+*************************************************************************/
 {
-    double constant = K12;
-    double multiplier = 0;
+	int j;
+	ullint *sourceSetIndicator = (ullint *)arenaAlloc(&ctx->results, ctx->numWordsSuper * sizeof(ullint));
 
-    for (int i = 0; i < numArcsSuper; i++)
-    {
+	memset(sourceSetIndicator, 0, ctx->numWordsSuper * sizeof(ullint));
+	for (j = 0; j < HPF_CUT_WORDS((int) ctx->numNodesSuper); j++)
+	{
+		sourceSetIndicator[j / 2] |= ((ullint) row[j]) << (32 * (j % 2));
+	}
+	/* bits past the last node are not part of the set */
+	if (ctx->numNodesSuper % WORD_BITS != 0)
+	{
+		sourceSetIndicator[ctx->numWordsSuper - 1] &= (1ULL << (ctx->numNodesSuper % WORD_BITS)) - 1;
+	}
+	setBit(sourceSetIndicator, ctx->sourceSuper);
+	sourceSetIndicator[ctx->sinkSuper / WORD_BITS] &= ~(1ULL << (ctx->sinkSuper % WORD_BITS));
 
-        if (arcListSuper[i].from->originalIndex == sourceSuper && difference[arcListSuper[i].to->originalIndex] == 1)
-        {
-            constant += arcListSuper[i].constant;
-            multiplier += arcListSuper[i].multiplier;
-        }
-        else if (arcListSuper[i].to->originalIndex == sinkSuper && difference[arcListSuper[i].from->originalIndex] == 1 && roundNegativeCapacity == 0)
-        {
-            constant -= arcListSuper[i].constant;
-            multiplier -= arcListSuper[i].multiplier;
-        }
-    }
+	problem->optimalSourceSetIndicator = sourceSetIndicator;
+	problem->solved = 1;
+}
 
-    // printf("Constant: %lf, Mult: %lf\n", constant, multiplier);
-    return constant / (- multiplier);
+static void stopSearch(hpf_context *ctx)
+/*************************************************************************
+stopSearch - Makes ctx and the threads of its task pool stop searching for
+breakpoints
+*************************************************************************/
+{
+	ctx->isSearchStopped = 1;
+#ifndef HPF_NO_THREADS
+	if (ctx->taskPool != NULL)
+	{
+		pthread_mutex_lock(&ctx->taskPool->lock);
+		ctx->taskPool->isStopped = 1;
+		pthread_mutex_unlock(&ctx->taskPool->lock);
+	}
+#endif
 }
 
-static void parametricCut(CutProblem *lowProblem, CutProblem *highProblem)
+static int isSearchStopped(hpf_context *ctx)
 /*************************************************************************
-parametricCut - Recursive function that solves the parametric cut problem
+isSearchStopped - Whether the breakpoint callback has stopped the search.
+Worker contexts learn this through the shared task pool.
 *************************************************************************/
 {
-	// print low, high + breakpoints
-	// printf("Lambda High: %.4f\nLambda Low: %.4f\n",highProblem->lambdaValue, lowProblem->lambdaValue);
+	int isStopped = (int) ctx->isSearchStopped;
+#ifndef HPF_NO_THREADS
+	if (!isStopped && ctx->taskPool != NULL)
+	{
+		pthread_mutex_lock(&ctx->taskPool->lock);
+		isStopped = (int) ctx->taskPool->isStopped;
+		pthread_mutex_unlock(&ctx->taskPool->lock);
+	}
+#endif
+	return isStopped;
+}
 
-    // determine difference between source sets of cut.
-    uint *pdifference_low_high;
-    differenceSourceSets(&pdifference_low_high, lowProblem->optimalSourceSetIndicator, highProblem->optimalSourceSetIndicator);
-    uint num_nodes_different_low_high = sum_array_uint(pdifference_low_high, numNodesSuper);
+static void emitBreakpoint(hpf_context *ctx, Breakpoint *breakpoint)
+/*************************************************************************
+emitBreakpoint - Passes a breakpoint that was appended to the breakpoints
+of the solve to the callback, if there is one, together with the nodes
+that are new since the previous breakpoint, and releases its source set.
+Breakpoints are appended in increasing order of lambda.
+*************************************************************************/
+{
+	ullint word;
+	int numAdded = 0;
+	uint i, j;
 
-	/* find lambda value for which the optimal cut functions(expressed as a function of lambda) for the lower bound and upper bound problem intersect. */
-	if (num_nodes_different_low_high > 0)
+	if (ctx->breakpointCallback == NULL)
 	{
-        // find intersection using method outlined in Hochbaum 2003 on inverse spanning-tree.
-        double Klow = internalCutCapacity(lowProblem->optimalSourceSetIndicator);
-        double Khigh = internalCutCapacity(highProblem->optimalSourceSetIndicator);
-        double K12 = Klow - Khigh;
-        // printf("K low: %lf, high; %lf, diff: %lf\n", Klow, Khigh, K12);
+		return;
+	}
+
+	for (i = 0; i < ctx->numWordsSuper; i++)
+	{
+		word = breakpoint->sourceSetIndicator[i] & ~ctx->emittedSourceSet[i];
+		ctx->emittedSourceSet[i] |= word;
+		for (j = i * WORD_BITS; word != 0; word >>= 1, j++)
+		{
+			if (word & 1)
+			{
+				ctx->addedNodes[numAdded++] = (int) j;
+				if (ctx->emittedIndices != NULL)
+				{
+					ctx->emittedIndices[j] = ctx->numEmittedBreakpoints;
+				}
+			}
+		}
+	}
+
+	packSourceSet(ctx, breakpoint->sourceSetIndicator, ctx->packedSourceSet);
+	if (ctx->breakpointCallback(ctx->callbackData, ctx->numEmittedBreakpoints, breakpoint->lambdaValue, ctx->packedSourceSet, numAdded, ctx->addedNodes) != 0)
+	{
+		stopSearch(ctx);
+	}
+	++ ctx->numEmittedBreakpoints;
+
+	free(breakpoint->sourceSetIndicator);
+	breakpoint->sourceSetIndicator = NULL;
+}
+
+static int * breakpointIndices(hpf_context *ctx, int numBreakpoints)
+/*************************************************************************
+breakpointIndices - Index of the first breakpoint whose source set contains
+each node, numBreakpoints for nodes that are never in the source set. The
+source sets are nested, so only the nodes that are new in a breakpoint are
+visited.
+*************************************************************************/
+{
+	Breakpoint *currentBreakpoint;
+	ullint *previous;
+	ullint word;
+	int *indices;
+	uint i, j;
+	int k;
+
+	if ((indices = (int *)malloc(ctx->numNodesSuper * sizeof(int))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+	previous = (ullint *)arenaAlloc(&ctx->scratch, ctx->numWordsSuper * sizeof(ullint));
+
+	for (i = 0; i < ctx->numNodesSuper; i++)
+	{
+		indices[i] = numBreakpoints;
+	}
+	for (i = 0; i < ctx->numWordsSuper; i++)
+	{
+		previous[i] = 0;
+	}
+
+	currentBreakpoint = ctx->firstBreakpoint;
+	for (k = 0; k < numBreakpoints; k++)
+	{
+		for (i = 0; i < ctx->numWordsSuper; i++)
+		{
+			word = currentBreakpoint->sourceSetIndicator[i] & ~previous[i];
+			previous[i] |= word;
+			for (j = i * WORD_BITS; word != 0; word >>= 1, j++)
+			{
+				if (word & 1)
+				{
+					indices[j] = k;
+				}
+			}
+		}
+		currentBreakpoint = currentBreakpoint->next;
+	}
+
+	return indices;
+}
+
+static int firstSignChange(const double *lambdas, int first, int last, double constant, double multiplier)
+/*************************************************************************
+firstSignChange - First breakpoint k from first to last - 1 at which the
+capacity constant + multiplier * lambdas[k] is positive if the multiplier
+is, and not positive if it is negative, or last if there is none. The
+lambdas are increasing, so the breakpoints are searched by bisection.
+*************************************************************************/
+{
+	int middle;
+
+	while (first < last)
+	{
+		middle = first + (last - first) / 2;
+		if ((constant + multiplier * lambdas[middle] > 0) == (multiplier > 0))
+		{
+			last = middle;
+		}
+		else
+		{
+			first = middle + 1;
+		}
+	}
+	return first;
+}
+
+static void evaluateBreakpointCuts(hpf_context *ctx)
+/*************************************************************************
+evaluateBreakpointCuts - Capacity of the source set of every breakpoint at
+its lambda, which is the minimum cut there. The source sets are nested, so
+an arc is cut by the breakpoints from the first one whose source set
+contains its tail up to, but not including, the first one whose source set
+contains its head. Its constant and multiplier are added at the first of
+these and subtracted after the last, so that the running sums give the cut
+of every breakpoint, in time linear in the number of arcs. If negative
+capacities are rounded, an arc with a multiplier only counts where its
+capacity is positive.
+*************************************************************************/
+{
+	Breakpoint *currentBreakpoint;
+	int numBreakpoints = 0;
+	int *indices;
+	int first, last, k;
+	uint i;
+	double constant, multiplier;
+	double *lambdas, *constantSums, *multiplierSums;
+
+	for (currentBreakpoint = ctx->firstBreakpoint; currentBreakpoint != NULL; currentBreakpoint = currentBreakpoint->next)
+	{
+		++numBreakpoints;
+	}
+
+	if ((ctx->cutValues = (double *)malloc((numBreakpoints + 1) * sizeof(double))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+	lambdas = (double *)arenaAlloc(&ctx->scratch, (numBreakpoints + 1) * sizeof(double));
+	constantSums = (double *)arenaAlloc(&ctx->scratch, (numBreakpoints + 1) * sizeof(double));
+	multiplierSums = (double *)arenaAlloc(&ctx->scratch, (numBreakpoints + 1) * sizeof(double));
+
+	currentBreakpoint = ctx->firstBreakpoint;
+	for (k = 0; k <= numBreakpoints; k++)
+	{
+		if (k < numBreakpoints)
+		{
+			lambdas[k] = currentBreakpoint->lambdaValue;
+			currentBreakpoint = currentBreakpoint->next;
+		}
+		constantSums[k] = 0;
+		multiplierSums[k] = 0;
+	}
+
+	/* the source sets of a callback have been released once passed on */
+	indices = (ctx->breakpointCallback != NULL) ? ctx->emittedIndices : breakpointIndices(ctx, numBreakpoints);
+
+	for (i = 0; i < ctx->numArcsSuper; ++i)
+	{
+		first = indices[ctx->arcListSuper[i].from];
+		last = indices[ctx->arcListSuper[i].to];
+		first = (first < 0) ? numBreakpoints : first;
+		last = (last < 0) ? numBreakpoints : last;
+		constant = ctx->constantSuper[i];
+		multiplier = ctx->multiplierSuper[i];
+
+		if (ctx->roundNegativeCapacity && multiplier > 0)
+		{
+			first = firstSignChange(lambdas, first, last, constant, multiplier);
+		}
+		else if (ctx->roundNegativeCapacity && multiplier < 0)
+		{
+			last = firstSignChange(lambdas, first, last, constant, multiplier);
+		}
+		else if (ctx->roundNegativeCapacity && constant < 0)
+		{
+			continue;
+		}
+
+		if (first < last)
+		{
+			constantSums[first] += constant;
+			constantSums[last] -= constant;
+			multiplierSums[first] += multiplier;
+			multiplierSums[last] -= multiplier;
+		}
+	}
+
+	constant = 0;
+	multiplier = 0;
+	for (k = 0; k < numBreakpoints; k++)
+	{
+		constant += constantSums[k];
+		multiplier += multiplierSums[k];
+		ctx->cutValues[k] = constant + multiplier * lambdas[k];
+	}
+
+	if (ctx->breakpointCallback == NULL)
+	{
+		free(indices);
+	}
+}
+
+static int statValue(ullint counter)
+/*************************************************************************
+statValue - A counter as an int of the stats output, capped at INT_MAX
+*************************************************************************/
+{
+	return (counter > INT_MAX) ? INT_MAX : (int) counter;
+}
+
+static void prepareOutput (hpf_context *ctx, int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5] )
+{
+/*************************************************************************
+printOutput
+*************************************************************************/
+	Breakpoint *currentBreakpoint;
+	int i;
+	int j;
+
+	stats[0] = statValue(ctx->numArcScans);
+	stats[1] = statValue(ctx->numMergers);
+	stats[2] = statValue(ctx->numPushes);
+	stats[3] = statValue(ctx->numRelabels);
+	stats[4] = statValue(ctx->numGaps);
+
+	/* count num breakpoints */
+	*numBreakpoints = 0;
+	currentBreakpoint = ctx->firstBreakpoint;
+	while (currentBreakpoint != NULL)
+	{
+		++*numBreakpoints;
+		currentBreakpoint = currentBreakpoint->next;
+	}
+
+	double* breakpointsPointer;
+	/* print lambda values */
+	if ((breakpointsPointer = (double *)malloc(*numBreakpoints * sizeof(double))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+
+	currentBreakpoint = ctx->firstBreakpoint;
+	for (i = 0; i < *numBreakpoints; i++)
+	{
+		breakpointsPointer[i] = (double) currentBreakpoint->lambdaValue;
+		currentBreakpoint = currentBreakpoint->next;
+	}
+
+	*breakpoints = breakpointsPointer;
+
+	/* print values nodes, see hpf_cut_format */
+	int* cutsPointer;
+	if (ctx->breakpointCallback != NULL)
+	{
+		/* the source sets have been passed on already */
+		cutsPointer = NULL;
+	}
+	else if (ctx->cutFormat == HPF_CUTS_INDEX)
+	{
+		cutsPointer = breakpointIndices(ctx, *numBreakpoints);
+	}
+	else
+	{
+		int rowLength = ctx->cutFormat == HPF_CUTS_PACKED ? HPF_CUT_WORDS((int) ctx->numNodesSuper) : (int) ctx->numNodesSuper;
+		if ((cutsPointer = (int *)malloc(*numBreakpoints * rowLength * sizeof(int))) == NULL)
+		{
+			printf("Could not allocate memory.\n");
+			exit(0);
+		}
+
+		currentBreakpoint = ctx->firstBreakpoint;
+		for (i = 0; i < *numBreakpoints; i++)
+		{
+			if (ctx->cutFormat == HPF_CUTS_PACKED)
+			{
+				packSourceSet(ctx, currentBreakpoint->sourceSetIndicator, (unsigned int *) &cutsPointer[i * rowLength]);
+			}
+			else
+			{
+				for (j = 0; j < ctx->numNodesSuper; j++)
+				{
+					cutsPointer[i * rowLength + j ] = (int) getBit(currentBreakpoint->sourceSetIndicator, j);
+				}
+			}
+			currentBreakpoint = currentBreakpoint->next;
+		}
+	}
+
+	*cuts = cutsPointer;
+}
+
+static Capacity superArcCapacity(hpf_context *ctx, uint arc, const CutProblem *problem)
+/*************************************************************************
+superArcCapacity - capacity of a super arc at the lambda of a problem,
+scaled by its lambdaDenominator if its capacities are exact
+*************************************************************************/
+{
+    Capacity capacity;
+
+    if (problem->lambdaDenominator > 0)
+    {
+        capacity = (Capacity) ((llint) ctx->multiplierSuper[arc] * problem->lambdaNumerator + (llint) ctx->constantSuper[arc] * problem->lambdaDenominator);
+    }
+    else
+    {
+        capacity = (Capacity) (ctx->multiplierSuper[arc] * problem->lambdaValue + ctx->constantSuper[arc]);
+    }
+
+    if (capacity < 0)
+    {
+        if (ctx->roundNegativeCapacity)
+        {
+            capacity = 0;
+        }
+        else
+        {
+            printf("Negative capacity for lambda equal to %f. Set roundNegativeCapacity to 1 if the value should be rounded to 0.\n", problem->lambdaValue);
+            exit(0);
+        }
+    }
+    return capacity;
+}
+
+static void copyArcNew(hpf_context *ctx, int *nodeMap, uint old, Arc *new, const CutProblem *problem)
+/*************************************************************************
+copyArcNew - copy basic info of super arc old and point to new nodes
+*************************************************************************/
+{
+	initializeArc(new);
+	new->capacity = superArcCapacity(ctx, old, problem);
+
+	/* set start and end node */
+	new->from = nodeMap[ctx->arcListSuper[old].from];
+	new->to = nodeMap[ctx->arcListSuper[old].to];
+}
+
+static void copyArcAdd(hpf_context *ctx, uint old, Arc *new, const CutProblem *problem)
+/*************************************************************************
+copyArcAdd - update arc by adding super arc old
+*************************************************************************/
+
+{
+    new->capacity += superArcCapacity(ctx, old, problem);
+}
+
+static void destroyProblem(CutProblem *problem, int destroySourceSetIndicator)
+/*************************************************************************
+destroyProblem - Destruct function for CutProblem struct
+*************************************************************************/
+{
+	/* the memory itself is released by rewinding the arenas */
+	problem->sourceSet = NULL;
+	problem->sinkSet = NULL;
+	problem->nodeList = NULL;
+	problem->originalIndex = NULL;
+	problem->arcList = NULL;
+    if (destroySourceSetIndicator)
+    {
+        problem->optimalSourceSetIndicator = NULL;
+        problem->interiorArcFlow = NULL;
+    }
+}
+
+static uint isExactLambda(hpf_context *ctx, double numerator, double denominator)
+/*************************************************************************
+isExactLambda - The capacities at lambda (numerator + d) / denominator
+with -1 <= d <= 1, multiplied by denominator, are integers whose absolute
+values add up to less than EXACT_CAPACITY_LIMIT, so that no flow or excess
+is rounded
+*************************************************************************/
+{
+	return (ctx->integralCapacities && denominator > 0 && denominator < EXACT_CAPACITY_LIMIT && denominator * ctx->constantSum + (dabs(numerator) + 1) * ctx->multiplierSum < EXACT_CAPACITY_LIMIT);
+}
+
+static void setExactLambda(CutProblem *problem, llint numerator, llint denominator)
+/*************************************************************************
+setExactLambda - Solves problem at lambda numerator / denominator with its
+capacities multiplied by denominator, which makes them integers. The cut
+does not change, and no flow or excess is rounded. isExactLambda has to
+hold for the lambda.
+*************************************************************************/
+{
+	problem->lambdaValue = (double) numerator / (double) denominator;
+	problem->lambdaNumerator = numerator;
+	problem->lambdaDenominator = denominator;
+}
+
+static void initializeContractedProblem(hpf_context *ctx, CutProblem *problem, const double lambdaValue, ullint *solutionLow, ullint *solutionHigh)
+/*************************************************************************
+initializeContractedProblem - Setup problems for parametric cut by
+contracting the super graph. Only the source sets that define the
+contraction are kept, the contracted graph is built when the problem is
+solved, so a problem takes no memory of the size of the graph.
+*************************************************************************/
+{
+	/* set cut parameters */
+	problem->cutValue = 0;
+
+	/* set solved indicator */
+	problem->solved = 0;
+
+	/* initialize optimal cut */
+	problem->optimalSourceSetIndicator = NULL;
+
+	/* initialize warm start information */
+	problem->keepInteriorFlows = (ctx->warmStart || ctx->sweepLambdas != NULL);
+	problem->numInteriorArcs = 0;
+	problem->interiorArcFlow = NULL;
+	problem->superArcFlow = NULL;
+
+	/* initialize new lambda value, exact if it is an integer */
+	problem->lambdaValue = lambdaValue;
+	problem->lambdaNumerator = 0;
+	problem->lambdaDenominator = 0;
+	if (isIntegral(lambdaValue) && isExactLambda(ctx, lambdaValue, 1))
+	{
+		setExactLambda(problem, (llint) lambdaValue, 1);
+	}
+	problem->lowSourceSet = solutionLow;
+	problem->highSourceSet = solutionHigh;
+
+	problem->numNodesInList = 0;
+	problem->numSourceSet = 0;
+	problem->numSinkSet = 0;
+	problem->numArcs = 0;
+	problem->arcList = NULL;
+	problem->nodeList = NULL;
+	problem->originalIndex = NULL;
+	problem->sourceSet = NULL;
+	problem->sinkSet = NULL;
+}
+
+static ullint * warmInteriorNodes(hpf_context *ctx, CutProblem *warmProblem)
+/*************************************************************************
+warmInteriorNodes - The super nodes that are interior nodes of warmProblem,
+allocated in the scratch arena
+*************************************************************************/
+{
+	uint i;
+	ullint *warmInterior = (ullint *)arenaAlloc(&ctx->scratch, ctx->numWordsSuper * sizeof(ullint));
+
+	for (i = 0; i < ctx->numWordsSuper; ++i)
+	{
+		warmInterior[i] = warmProblem->highSourceSet[i] & ~warmProblem->lowSourceSet[i];
+	}
+	warmInterior[ctx->sourceSuper / WORD_BITS] &= ~(1ULL << (ctx->sourceSuper % WORD_BITS));
+	warmInterior[ctx->sinkSuper / WORD_BITS] &= ~(1ULL << (ctx->sinkSuper % WORD_BITS));
+
+	return warmInterior;
+}
+
+static __inline double capacityScale(const CutProblem *problem)
+/*************************************************************************
+capacityScale - Factor by which the capacities of a problem are scaled
+*************************************************************************/
+{
+	return (problem->lambdaDenominator > 0) ? (double) problem->lambdaDenominator : 1.0;
+}
+
+static __inline void warmStartArc(hpf_context *ctx, CutProblem *problem, Arc *arc, double flow)
+/*************************************************************************
+warmStartArc - Initializes the flow on an interior arc with the final flow
+of the same arc in a solved problem. The flow is rounded to the nearest
+bound, such that the arc is either empty or saturated and can start outside
+the tree. The resulting excesses are added to the nodes.
+*************************************************************************/
+{
+	if (2 * flow * capacityScale(problem) >= (double) arc->capacity && isFlow(arc->capacity))
+	{
+		arc->flow = arc->capacity;
+		problem->nodeList[arc->from].excess -= arc->capacity;
+		problem->nodeList[arc->to].excess += arc->capacity;
+		++ ctx->numWarmStartArcs;
+	}
+}
+
+static void contractProblem(hpf_context *ctx, CutProblem *problem, CutProblem *warmProblem)
+/*************************************************************************
+contractProblem - Builds the graph of a problem in the scratch arena from
+the super graph, which is shared by all problems. Parallel source and sink
+arcs of a node are merged, and interior arcs keep the order of the super
+arcs. If warmProblem is not NULL, the interior arcs start from its final
+flows. Its flows are in order of super arc as well, so they are matched
+while the arcs are copied.
+*************************************************************************/
+{
+	uint numNodesProblem = ctx->numNodesSuper;
+	uint numArcsProblem = ctx->numArcsSuper;
+	Arc *arcListProblem = ctx->arcListSuper;
+	ullint *solutionLow = problem->lowSourceSet;
+	ullint *solutionHigh = problem->highSourceSet;
+	uint i, newIndexTo, newIndexFrom;
+	uint currentNode = 2;
+    uint currentSourceSet = 0;
+    uint currentSinkSet = 0;
+    uint currentArc = 0;
+	uint currentWarmArc = 0;
+	uint isWarm;
+	ullint *warmInterior = NULL;
+	int *nodeMap = ctx->nodeMap; /* indicator index of node in new nodeList. */
+
+#ifdef HPF_INTEGER_CAPACITIES
+	if (problem->lambdaDenominator == 0)
+	{
+		printf("The capacities for lambda equal to %f are not integral or too large. Build without HPF_INTEGER_CAPACITIES to solve this problem.\n", problem->lambdaValue);
+		exit(0);
+	}
+#endif
+
+	problem->numInteriorArcs = 0;
+
+	/* set size of node sets */
+	problem->numSourceSet = 1;
+	problem->numSinkSet = 1;
+	problem->numNodesInList = 2;
+
+    for (i = 0; i < numNodesProblem; i++)
+	{
+		if (i == ctx->sourceSuper)
+		{
+			nodeMap[i] = 0;
+		}
+		else if (i == ctx->sinkSuper)
+		{
+			nodeMap[i] = 1;
+		}
+        else if (i != ctx->sourceSuper && getBit(solutionLow, i) == 1)
+        {   // Source set nodes
+			nodeMap[i] = 0;
+            problem->numSourceSet++;
+        }
+        else if (i != ctx->sinkSuper && getBit(solutionHigh, i) == 0)
+        {
+            // sink set nodes
+			nodeMap[i] = 1;
+            problem->numSinkSet++;
+        }
+        else
+        {
+            nodeMap[i] = currentNode;
+			++currentNode;
+            problem->numNodesInList++;
+        }
+	}
+
+	/* allocate space for the node sets*/
+	problem->nodeList = (Node *)arenaAlloc(&ctx->scratch, problem->numNodesInList * sizeof(Node));
+	problem->originalIndex = (int *)arenaAlloc(&ctx->scratch, problem->numNodesInList * sizeof(int));
+	problem->sourceSet = (uint *)arenaAlloc(&ctx->scratch, problem->numSourceSet * sizeof(uint));
+	problem->sinkSet = (uint *)arenaAlloc(&ctx->scratch, problem->numSinkSet * sizeof(uint));
+
+    // initialize nodes
+    for (i = 0; i < problem->numNodesInList; i++)
+    {
+        initializeNode(&problem->nodeList[i]);
+    }
+
+     /* source is always first node */
+    problem->originalIndex[0] = -1; /* indicate artificial source node */
+    problem->originalIndex[1] = -2; /* indicate artificial sink node */
+
+	/* create new node sets, super node i has original index i */
+	for (i = 0; i < numNodesProblem; i++)
+	{
+		if (nodeMap[i] == 0)
+		{
+			problem->sourceSet[currentSourceSet] = i;
+			currentSourceSet++;
+		}
+		else if (nodeMap[i] == 1)
+		{
+			problem->sinkSet[currentSinkSet] = i;
+			currentSinkSet++;
+		}
+		else
+		{
+			problem->originalIndex[nodeMap[i]] = (int) i;
+		}
+	}
+
+    int *sourceAdjacentArcIndices = ctx->sourceAdjacentArcIndices;
+    int *sinkAdjacentArcIndices = ctx->sinkAdjacentArcIndices;
+
+	/* initialize indices */
+	for (i = 0; i < problem->numNodesInList; i++)
+	{
+		sourceAdjacentArcIndices[i] = -1;
+		sinkAdjacentArcIndices[i] = -1;
+	}
+
+	/* determine new number of arcs */
+	for (i = 0; i < numArcsProblem; i++)
+	{
+		newIndexFrom = nodeMap[arcListProblem[i].from];
+		newIndexTo = nodeMap[arcListProblem[i].to];
+
+		if (newIndexFrom == newIndexTo || newIndexTo==0 || newIndexFrom==1 || (newIndexFrom == 0 && newIndexTo == 1))
+		{
+		}
+		else if (newIndexFrom == 0)
+		{
+			if (sourceAdjacentArcIndices[newIndexTo] == -1)
+			{
+				sourceAdjacentArcIndices[newIndexTo] = currentArc;
+				++currentArc;
+			}
+		}
+		else if (newIndexTo == 1)
+		{
+			if (sinkAdjacentArcIndices[newIndexFrom] == -1)
+			{
+				sinkAdjacentArcIndices[newIndexFrom] = currentArc;
+				++currentArc;
+			}
+		}
+		else
+		{
+			++currentArc;
+			++problem->numInteriorArcs;
+		}
+	}
+
+	/* set number of arcs */
+	problem->numArcs = currentArc;
+
+	/* allocate space for arcs */
+	problem->arcList = (Arc *)arenaAlloc(&ctx->scratch, problem->numArcs * sizeof(Arc));
+
+	if (warmProblem != NULL && problem->numInteriorArcs > 0)
+	{
+		++ ctx->numWarmStarts;
+		warmInterior = warmInteriorNodes(ctx, warmProblem);
+	}
+
+	/* copy arcs */
+	currentArc = 0;
+	for (i = 0; i < numArcsProblem; i++)
+	{
+		newIndexFrom = nodeMap[arcListProblem[i].from];
+		newIndexTo = nodeMap[arcListProblem[i].to];
+
+		/* arcs with a final flow in warmProblem */
+		isWarm = warmInterior != NULL && arcListProblem[i].from != arcListProblem[i].to && getBit(warmInterior, arcListProblem[i].from) && getBit(warmInterior, arcListProblem[i].to);
+
+		if (newIndexFrom == newIndexTo || newIndexTo==0 || newIndexFrom==1 ||  (newIndexFrom == 0 && newIndexTo == 1))
+		{
+		}
+		else if (newIndexFrom == 0)
+		{
+			if (sourceAdjacentArcIndices[newIndexTo] == currentArc )
+			{
+				copyArcNew(ctx, nodeMap, i, &problem->arcList[currentArc], problem);
+				++currentArc;
+			}
+			else
+			{
+				copyArcAdd(ctx, i, &problem->arcList[sourceAdjacentArcIndices[newIndexTo]], problem);
+			}
+		}
+		else if (newIndexTo == 1)
+		{
+			if (sinkAdjacentArcIndices[newIndexFrom] == currentArc)
+			{
+				copyArcNew(ctx, nodeMap, i, &problem->arcList[currentArc], problem);
+				++currentArc;
+			}
+			else
+			{
+				copyArcAdd(ctx, i, &problem->arcList[sinkAdjacentArcIndices[newIndexFrom]], problem);
+			}
+		}
+		else
+		{
+			copyArcNew(ctx, nodeMap, i, &problem->arcList[currentArc], problem);
+			if (isWarm)
+			{
+				warmStartArc(ctx, problem, &problem->arcList[currentArc], warmProblem->interiorArcFlow[currentWarmArc]);
+			}
+			++currentArc;
+		}
+
+		if (isWarm)
+		{
+			++currentWarmArc;
+		}
+	}
+}
+
+static void initialSourceSets(hpf_context *ctx, ullint *lowSourceSet, ullint *highSourceSet)
+/*************************************************************************
+initialSourceSets - Source sets whose contraction gives the first
+problems: the nodes fixed in the source set, and all nodes but those fixed
+in the sink set. Without a reduced graph no node is contracted.
+*************************************************************************/
+{
+    uint i;
+
+    for (i = 0; i < ctx->numWordsSuper; i++)
+    {
+        lowSourceSet[i] = (ctx->fixedSourceSet != NULL) ? ctx->fixedSourceSet[i] : 0;
+        highSourceSet[i] = 0;
+    }
+    for (i = 0; i < ctx->numNodesSuper; i++)
+    {
+        if (ctx->fixedSinkSet == NULL || getBit(ctx->fixedSinkSet, i) == 0)
+        {
+            setBit(highSourceSet, i);
+        }
+    }
+}
+
+static void initializeParametricCut(hpf_context *ctx, CutProblem *lowProblem, CutProblem *highProblem)
+/*************************************************************************
+initializeParametricCut - Set up data structures for parametric cut
+*************************************************************************/
+{
+    ullint *all_source, *all_sink;
+	// disable contraction by passing dummy low/high problem solutions.
+    all_sink = (ullint *)arenaAlloc(&ctx->scratch, ctx->numWordsSuper * sizeof(ullint));
+    all_source = (ullint *)arenaAlloc(&ctx->scratch, ctx->numWordsSuper * sizeof(ullint));
+    initialSourceSets(ctx, all_sink, all_source);
+
+    /* initialize problem for LAMBDA_LOW */
+    initializeContractedProblem(ctx, lowProblem, ctx->LAMBDA_LOW, all_sink, all_source);
+
+	if (ctx->useParametricCut == 1)
+	{
+		/* initialize problem for LAMBDA_HIGH */
+		initializeContractedProblem(ctx, highProblem, ctx->LAMBDA_HIGH, all_sink, all_source);
+	}
+}
+
+static void addBreakpoint(hpf_context *ctx, double lambdaValue, ullint *sourceSetIndicator)
+/*************************************************************************
+addBreakpoint - Adds a breakpoint to the linkedlist, unless the search
+has been stopped by the breakpoint callback
+*************************************************************************/
+{
+	Breakpoint *newBreakpoint;
+	uint i;
+
+    // printf("New breakpoint: %lf\n", lambdaValue);
+
+	if (ctx->isSearchStopped)
+	{
+		return;
+	}
+
+	/* allocate memory for breakpoint*/
+	if ((newBreakpoint= (Breakpoint*)malloc(sizeof(Breakpoint))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+
+	/* assign values */
+	newBreakpoint->lambdaValue = lambdaValue;
+	newBreakpoint->next = NULL;
+
+	/* assign space for cut */
+	if ((newBreakpoint->sourceSetIndicator = (ullint*)malloc(ctx->numWordsSuper * sizeof(ullint))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+
+	/* copy cut */
+	for (i = 0; i < ctx->numWordsSuper; i++)
+	{
+		newBreakpoint->sourceSetIndicator[i] = sourceSetIndicator[i];
+	}
+
+	/* add breakpoint to linkedlist */
+	if (ctx->lastBreakpoint == NULL)
+	{
+		/* initialize list */
+		ctx->firstBreakpoint = newBreakpoint;
+		ctx->lastBreakpoint = newBreakpoint;
+	}
+	else
+	{
+		/* add new element to linked list*/
+		ctx->lastBreakpoint->next = newBreakpoint;
+		/* update head */
+		ctx->lastBreakpoint = newBreakpoint;
+	}
+
+	emitBreakpoint(ctx, newBreakpoint);
+}
+
+static void createMemoryStructures(hpf_context *ctx)
+/*************************************************************************
+createMemoryStructures - creates memory structures
+*************************************************************************/
+{
+	uint from;
+	uint to;
+	uint i;
+	Capacity capacity;
+
+	/* create memory structures */
+	createOutOfTree(ctx);
+
+	for (i=0; i<ctx->numArcs; i++)
+	{
+		to = ctx->arcList[i].to;
+		from = ctx->arcList[i].from;
+		capacity = ctx->arcList[i].capacity;
+
+		if (!((ctx->source == to) || (ctx->sink == from) || (from == to)))
+		{
+			if ((ctx->source == from) && (to == ctx->sink))
+			{
+				ctx->arcList[i].flow = capacity;
+			} else if (to == ctx->sink) {
+				addOutOfTreeNode(ctx, &ctx->nodesList[to], &ctx->arcList[i]);
+			} else if (isFlow(ctx->arcList[i].flow)) {
+				/* saturated by a warm start: only the reverse arc is residual */
+				ctx->arcList[i].direction = 0;
+				addOutOfTreeNode(ctx, &ctx->nodesList[to], &ctx->arcList[i]);
+			} else {
+				addOutOfTreeNode(ctx, &ctx->nodesList[from], &ctx->arcList[i]);
+			}
+		}
+	}
+
+	/* allocate memory for root and label count */
+	ctx->strongRoots = (Root *)arenaAlloc(&ctx->scratch, ctx->numNodes * sizeof(Root));
+	ctx->labelCount = (uint *)arenaAlloc(&ctx->scratch, ctx->numNodes * sizeof(uint));
+	createActiveLabels(ctx, &ctx->scratch, ctx->numNodes);
+
+	/* Initialization of root & labelcount */
+	for (i = 0; i<ctx->numNodes; ++i)
+	{
+		initializeRoot(&ctx->strongRoots[i]);
+		ctx->labelCount[i] = 0;
+	}
+}
+
+static void evaluateCut(CutProblem *problem)
+/*************************************************************************
+evaluateCut - Evaluates optimal cut parameters for a given problem
+*************************************************************************/
+{
+	uint i;
+	int originalIndexFrom;
+	int originalIndexTo;
+	for (i = 0; i < problem->numArcs; ++i)
+	{
+		originalIndexFrom = problem->originalIndex[problem->arcList[i].from];
+		originalIndexTo = problem->originalIndex[problem->arcList[i].to];
+		if ((originalIndexFrom == -1 || getBit(problem->optimalSourceSetIndicator, originalIndexFrom) == 1) && (originalIndexTo == -2 || getBit(problem->optimalSourceSetIndicator, originalIndexTo) == 0 ) )
+		{
+		  problem->cutValue += problem->arcList[i].capacity;
+		}
+	}
+}
+
+static void storeInteriorFlows(hpf_context *ctx, CutProblem *problem)
+/*************************************************************************
+storeInteriorFlows - Keeps the final flow on the interior arcs of a solved
+problem, so that it can warm start the next problem
+*************************************************************************/
+{
+	uint i;
+	uint currentInteriorArc = 0;
+	Arc *arc;
+
+	if (!problem->keepInteriorFlows || problem->numInteriorArcs == 0)
+	{
+		return;
+	}
+
+	problem->interiorArcFlow = (double *)arenaAlloc(&ctx->results, problem->numInteriorArcs * sizeof(double));
+
+	for (i = 0; i < problem->numArcs; ++i)
+	{
+		arc = &problem->arcList[i];
+		if (problem->originalIndex[arc->from] >= 0 && problem->originalIndex[arc->to] >= 0)
+		{
+			problem->interiorArcFlow[currentInteriorArc] = (double) arc->flow / capacityScale(problem);
+			++currentInteriorArc;
+		}
+	}
+}
+
+static void storeSuperArcFlows(hpf_context *ctx, CutProblem *problem)
+/*************************************************************************
+storeSuperArcFlows - Writes the flow of every super arc of a solved
+problem to superArcFlow, unscaled. The arcs are matched to those of the
+problem as contractProblem copied them. The flow of an arc that merges
+parallel source or sink arcs is split among them in order, each up to its
+capacity. Arcs from the source set to the sink set are saturated, and
+other arcs that were left out carry no flow.
+*************************************************************************/
+{
+	uint i, newIndexFrom, newIndexTo;
+	uint currentArc = 0;
+	int arc;
+	Capacity capacity, flow;
+	Capacity *remaining = (Capacity *)arenaAlloc(&ctx->scratch, (problem->numArcs + 1) * sizeof(Capacity));
+	double scale = capacityScale(problem);
+
+	for (i = 0; i < problem->numArcs; ++i)
+	{
+		remaining[i] = problem->arcList[i].flow;
+	}
+
+	for (i = 0; i < ctx->numArcsSuper; ++i)
+	{
+		newIndexFrom = ctx->nodeMap[ctx->arcListSuper[i].from];
+		newIndexTo = ctx->nodeMap[ctx->arcListSuper[i].to];
+
+		if (newIndexFrom == newIndexTo || newIndexTo == 0 || newIndexFrom == 1)
+		{
+			flow = 0;
+		}
+		else if (newIndexFrom == 0 && newIndexTo == 1)
+		{
+			flow = superArcCapacity(ctx, i, problem);
+		}
+		else
+		{
+			if (newIndexFrom == 0)
+			{
+				arc = ctx->sourceAdjacentArcIndices[newIndexTo];
+			}
+			else if (newIndexTo == 1)
+			{
+				arc = ctx->sinkAdjacentArcIndices[newIndexFrom];
+			}
+			else
+			{
+				arc = (int) currentArc;
+			}
+			if (arc == (int) currentArc)
+			{
+				++currentArc;
+			}
+
+			capacity = superArcCapacity(ctx, i, problem);
+			flow = (remaining[arc] < capacity) ? remaining[arc] : capacity;
+			remaining[arc] -= flow;
+		}
+		problem->superArcFlow[i] = (double) flow / scale;
+	}
+}
+
+static void keepFlows(hpf_context *ctx, CutProblem *kept, CutProblem *problem)
+/*************************************************************************
+keepFlows - Copies the final interior flows of a solved problem and the
+source sets of its contraction to a problem whose arrays have room for all
+super arcs and nodes
+*************************************************************************/
+{
+	if (problem->interiorArcFlow == NULL)
+	{
+		kept->solved = 0;
+		return;
+	}
+
+	memcpy(kept->lowSourceSet, problem->lowSourceSet, ctx->numWordsSuper * sizeof(ullint));
+	memcpy(kept->highSourceSet, problem->highSourceSet, ctx->numWordsSuper * sizeof(ullint));
+	memcpy(kept->interiorArcFlow, problem->interiorArcFlow, problem->numInteriorArcs * sizeof(double));
+	kept->numInteriorArcs = problem->numInteriorArcs;
+	kept->lambdaValue = problem->lambdaValue;
+	kept->lambdaNumerator = problem->lambdaNumerator;
+	kept->lambdaDenominator = problem->lambdaDenominator;
+	kept->solved = 1;
+}
+
+static void releaseContraction(hpf_context *ctx, CutProblem *problem, ArenaMark mark)
+/*************************************************************************
+releaseContraction - Releases the graph of a solved problem, only its cut,
+cut value and flows remain
+*************************************************************************/
+{
+	arenaRewind(&ctx->scratch, mark);
+	problem->arcList = NULL;
+	problem->nodeList = NULL;
+	problem->originalIndex = NULL;
+	problem->sourceSet = NULL;
+	problem->sinkSet = NULL;
+}
+
+static double startPhase(void)
+/*************************************************************************
+startPhase - Start time of a phase of solveProblem
+*************************************************************************/
+{
+#ifndef HPF_NO_PROFILE
+	return wallTime();
+#else
+	return 0;
+#endif
+}
+
+static double endPhase(hpf_context *ctx, hpf_phase phase, double start)
+/*************************************************************************
+endPhase - Adds the time since start to a phase and returns the start time
+of the next phase
+*************************************************************************/
+{
+#ifndef HPF_NO_PROFILE
+	double now = wallTime();
+
+	ctx->phaseTimes[phase] += now - start;
+	return now;
+#else
+	return start;
+#endif
+}
+
+static void countSubproblem(hpf_context *ctx)
+/*************************************************************************
+countSubproblem - Counts the contracted graph of ctx at the current level
+of the recursion
+*************************************************************************/
+{
+#ifndef HPF_NO_PROFILE
+	LevelStats *level;
+#endif
+
+	++ ctx->numSubproblems;
+
+#ifndef HPF_NO_PROFILE
+	if (ctx->recursionLevel >= ctx->levelCapacity)
+	{
+		ctx->levelCapacity = 2 * ctx->recursionLevel + 16;
+		if ((ctx->levels = (LevelStats *)realloc(ctx->levels, ctx->levelCapacity * sizeof(LevelStats))) == NULL)
+		{
+			printf("Could not allocate memory.\n");
+			exit(0);
+		}
+	}
+	for (; ctx->numLevels <= ctx->recursionLevel; ++ ctx->numLevels)
+	{
+		memset(&ctx->levels[ctx->numLevels], 0, sizeof(LevelStats));
+	}
+
+	level = &ctx->levels[ctx->recursionLevel];
+	++ level->numProblems;
+	level->numNodes += ctx->numNodes;
+	level->numArcs += ctx->numArcs;
+#endif
+}
+
+static void solveProblem(hpf_context *ctx, CutProblem *problem, uint maximalSourceSet, CutProblem *warmProblem)
+/*************************************************************************
+solveProblem - solves a single instance of cut problem. If warmProblem is
+not NULL, its final flows are used as the starting pseudoflow.
+*************************************************************************/
+{
+	uint i;
+	ullint *tempSourceSet;
+	ArenaMark solveMark;
+	double phaseStart = startPhase();
+
+	/* everything allocated from here on is released at the end. The
+	   arcs of a maximal source set are reversed below and not warm started. */
+	solveMark = arenaMark(&ctx->scratch);
+	if (warmProblem == NULL || warmProblem->interiorArcFlow == NULL || !problem->keepInteriorFlows || maximalSourceSet == 1)
+	{
+		warmProblem = NULL;
+	}
+	contractProblem(ctx, problem, warmProblem);
+
+	ctx->nodesList = problem->nodeList;
+	ctx->numNodes = problem->numNodesInList;
+	ctx->numArcs = problem->numArcs;
+	problem->cutValue = 0.0;
+	countSubproblem(ctx);
+	if (problem->lambdaDenominator > 0)
+	{
+		++ ctx->numExactSubproblems;
+	}
+
+    // reset some globals
+    ctx->highestStrongLabel = 1;
+	ctx->lowestPositiveExcessNode = 0;
+
+
+	// handle empty problems
+	if (ctx->numNodes == 2)
+	{
+		/* assign nodes to source / sink set */
+		problem->optimalSourceSetIndicator = (ullint *)arenaAlloc(&ctx->results, ctx->numWordsSuper * sizeof(ullint));
+
+		for (i = 0; i < ctx->numWordsSuper; i++)
+		{
+			problem->optimalSourceSetIndicator[i] = 0;
+		}
+
+		for (i = 0; i < problem->numSourceSet; i++)
+		{
+			setBit(problem->optimalSourceSetIndicator, problem->sourceSet[i]);
+		}
+
+		/* determine cut value */
+		for (i = 0; i < problem->numArcs; i++)
+		{
+			if (problem->originalIndex[problem->arcList[i].from] == -1 && problem->originalIndex[problem->arcList[i].to] == -2)
+			{
+				problem->cutValue += problem->arcList[i].capacity;
+			}
+		}
+
+        if (problem->superArcFlow != NULL)
+        {
+            storeSuperArcFlows(ctx, problem);
+        }
+
+        problem->solved =1;
+		endPhase(ctx, HPF_PHASE_CONTRACT, phaseStart);
+		releaseContraction(ctx, problem, solveMark);
+		return;
+	}
+
+	if (maximalSourceSet == 1)
+	{
+		ctx->source = 1;
+		ctx->sink = 0;
+
+		/* allocate space for reversed arcs */
+		ctx->arcList = (Arc *)arenaAlloc(&ctx->scratch, ctx->numArcs * sizeof(Arc));
+
+		/* copy arcs such that arcs can be reversed */
+		for (i = 0; i < ctx->numArcs; i++)
+		{
+			/* initialize new arc*/
+			initializeArc(&ctx->arcList[i]);
+
+			// reverse direction
+			ctx->arcList[i].from = problem->arcList[i].to;
+			ctx->arcList[i].to = problem->arcList[i].from;
+
+			// assign capacity
+			ctx->arcList[i].capacity = problem->arcList[i].capacity;
+		}
+	}
+	else
+	{
+		ctx->source = 0;
+		ctx->sink = 1;
+
+		ctx->arcList = problem->arcList;
+	}
+	phaseStart = endPhase(ctx, HPF_PHASE_CONTRACT, phaseStart);
+
+	// solve
+	createMemoryStructures(ctx);
+	simpleInitialization(ctx);
+	phaseStart = endPhase(ctx, HPF_PHASE_INITIALIZE, phaseStart);
+	pseudoflowRegions(ctx);
+	pseudoflowPhase1(ctx);
+	phaseStart = endPhase(ctx, HPF_PHASE_PHASE1, phaseStart);
+
+	storeInteriorFlows(ctx, problem);
+	if (problem->superArcFlow != NULL)
+	{
+		recoverFlow(ctx);
+		storeSuperArcFlows(ctx, problem);
+	}
+
+	/* allocate memory for source set (possibly reversed), nodes not set
+	   below are in the sink set */
+	tempSourceSet = (ullint *)arenaAlloc(&ctx->results, ctx->numWordsSuper * sizeof(ullint));
+	for (i = 0; i < ctx->numWordsSuper; i++)
+	{
+		tempSourceSet[i] = 0;
+	}
+
+	// retrieve optimal sourceSet for nodes in graph
+	if (maximalSourceSet == 1) // reverse assignment to source and sink set
+	{
+		for (i = 2; i<ctx->numNodes; ++i) // start from 2 to ignore artificial source and sink
+		{
+			if (ctx->nodesList[i].label < ctx->numNodes)
+			{
+				setBit(tempSourceSet, problem->originalIndex[i]);
+			}
+		}
+	}
+	else
+	{
+		for (i = 2; i<ctx->numNodes; ++i) // start from 2 to ignore artificial source and sink
+		{
+			if (ctx->nodesList[i].label >= ctx->numNodes)
+			{
+				setBit(tempSourceSet, problem->originalIndex[i]);
+			}
+		}
+	}
+
+	// process cut for source set nodes
+	for (i = 0; i < problem->numSourceSet; i++)
+	{
+		setBit(tempSourceSet, problem->sourceSet[i]);
+	}
+
+	// assign cut
+	problem->optimalSourceSetIndicator = tempSourceSet;
+	evaluateCut(problem);
+	endPhase(ctx, HPF_PHASE_CUT, phaseStart);
+
+	ctx->arcList = NULL;
+
+    problem->solved =1;
+
+	// printCutProblem(problem);
+	freeMemorySolve(ctx);
+	releaseContraction(ctx, problem, solveMark);
+}
+
+static uint countDifference(hpf_context *ctx, ullint *lowOptimalSourceIndicator, ullint *highOptimalSourceIndicator)
+/*************************************************************************
+countDifference - Number of nodes in the high source set that are not in
+the low source set
+*************************************************************************/
+{
+    uint count = 0;
+    for (uint i = 0; i < ctx->numWordsSuper; i++)
+    {
+        count += popcount(highOptimalSourceIndicator[i] & ~lowOptimalSourceIndicator[i]);
+    }
+    return count;
+}
+
+static uint differenceSourceSets(hpf_context *ctx, ullint **ppdifference, ullint *lowOptimalSourceIndicator, ullint *highOptimalSourceIndicator)
+/*************************************************************************
+differenceSourceSets - Stores the nodes in the high source set that are not
+in the low source set as a bitset and returns their number
+*************************************************************************/
+{
+    uint count = 0;
+    *ppdifference = (ullint *)arenaAlloc(&ctx->results, ctx->numWordsSuper * sizeof(ullint));
+    ullint *pdifference = *ppdifference;
+    for (uint i = 0; i < ctx->numWordsSuper; i++)
+    {
+        pdifference[i] = highOptimalSourceIndicator[i] & ~lowOptimalSourceIndicator[i];
+        count += popcount(pdifference[i]);
+    }
+    return count;
+}
+
+static void createAdjacentArcsSuper(hpf_context *ctx)
+/*************************************************************************
+createAdjacentArcsSuper - Lists the arcs adjacent to every node of the
+super graph. The arcs of node i are stored from adjacentStartSuper[i] to
+adjacentStartSuper[i+1].
+*************************************************************************/
+{
+	uint i, from, to;
+	uint *next;
+
+	ctx->adjacentStartSuper = (uint *)arenaAlloc(&ctx->scratch, (ctx->numNodesSuper + 1) * sizeof(uint));
+	ctx->adjacentArcsSuper = (uint *)arenaAlloc(&ctx->scratch, 2 * ctx->numArcsSuper * sizeof(uint));
+
+	for (i = 0; i <= ctx->numNodesSuper; ++i)
+	{
+		ctx->adjacentStartSuper[i] = 0;
+	}
+	for (i = 0; i < ctx->numArcsSuper; ++i)
+	{
+		++ ctx->adjacentStartSuper[ctx->arcListSuper[i].from + 1];
+		++ ctx->adjacentStartSuper[ctx->arcListSuper[i].to + 1];
+	}
+	for (i = 0; i < ctx->numNodesSuper; ++i)
+	{
+		ctx->adjacentStartSuper[i+1] += ctx->adjacentStartSuper[i];
+	}
+
+	// fill using nodeMap as the insert position, it is overwritten later on
+	next = (uint *) ctx->nodeMap;
+	for (i = 0; i < ctx->numNodesSuper; ++i)
+	{
+		next[i] = ctx->adjacentStartSuper[i];
+	}
+	for (i = 0; i < ctx->numArcsSuper; ++i)
+	{
+		from = ctx->arcListSuper[i].from;
+		to = ctx->arcListSuper[i].to;
+		ctx->adjacentArcsSuper[next[from]++] = i;
+		if (to != from)
+		{
+			ctx->adjacentArcsSuper[next[to]++] = i;
+		}
+	}
+}
+
+static llint greatestCommonDivisor(llint a, llint b)
+/*************************************************************************
+greatestCommonDivisor - Of two nonnegative integers
+*************************************************************************/
+{
+	llint r;
+
+	while (b != 0)
+	{
+		r = a % b;
+		a = b;
+		b = r;
+	}
+	return a;
+}
+
+static double computeIntersect(hpf_context *ctx, ullint *lowOptimalSourceIndicator, ullint *highOptimalSourceIndicator, ullint *difference, llint *numerator, llint *denominator, llint *spread)
+/*************************************************************************
+computeIntersect - Lambda value where the cut capacities of the low and
+high source sets are equal. Only arcs adjacent to the difference of the two
+sets contribute to the difference of the cut capacities, so only those arcs
+are visited. If the capacities are integral, the intersection is also
+returned as the fraction numerator / denominator in lowest terms, otherwise
+denominator is 0. spread is the sum of the absolute multipliers of the
+source and sink arcs of the difference, which bounds the denominator of
+every breakpoint between the two sets.
+*************************************************************************/
+{
+    double constant = 0;
+    double multiplier = 0;
+    double multiplierSum = 0;
+    ullint word;
+    uint i, j, k, arc, from, to;
+    llint r;
+
+    for (i = 0; i < ctx->numWordsSuper; i++)
+    {
+        for (word = difference[i], j = i * WORD_BITS; word != 0; word >>= 1, j++)
+        {
+            if ((word & 1) == 0)
+            {
+                continue;
+            }
+
+            for (k = ctx->adjacentStartSuper[j]; k < ctx->adjacentStartSuper[j+1]; k++)
+            {
+                arc = ctx->adjacentArcsSuper[k];
+                from = ctx->arcListSuper[arc].from;
+                to = ctx->arcListSuper[arc].to;
+
+                if (from == ctx->sourceSuper)
+                {
+                    if (to == j)
+                    {
+                        constant += ctx->constantSuper[arc];
+                        multiplier += ctx->multiplierSuper[arc];
+                        multiplierSum += dabs(ctx->multiplierSuper[arc]);
+                    }
+                }
+                else if (to == ctx->sinkSuper)
+                {
+                    if (from == j && ctx->roundNegativeCapacity == 0)
+                    {
+                        constant -= ctx->constantSuper[arc];
+                        multiplier -= ctx->multiplierSuper[arc];
+                    }
+                    if (from == j)
+                    {
+                        multiplierSum += dabs(ctx->multiplierSuper[arc]);
+                    }
+                }
+                else if (to == j && getBit(lowOptimalSourceIndicator, from) == 1)
+                {
+                    // cut by the low source set only
+                    constant += ctx->constantSuper[arc];
+                }
+                else if (from == j && getBit(highOptimalSourceIndicator, to) == 0)
+                {
+                    // cut by the high source set only
+                    constant -= ctx->constantSuper[arc];
+                }
+            }
+        }
+    }
+
+    // printf("Constant: %lf, Mult: %lf\n", constant, multiplier);
+    /* the sums of integral capacities are exact, see checkIntegralCapacities */
+    *numerator = 0;
+    *denominator = 0;
+    *spread = 0;
+    if (ctx->integralCapacities && multiplier != 0)
+    {
+        *numerator = (llint) (multiplier > 0 ? - constant : constant);
+        *denominator = (llint) dabs(multiplier);
+        *spread = (llint) multiplierSum;
+        r = greatestCommonDivisor(*numerator < 0 ? - *numerator : *numerator, *denominator);
+        *numerator /= r;
+        *denominator /= r;
+    }
+    return constant / (- multiplier);
+}
+
+static size_t scratchArenaBytes(hpf_context *ctx)
+/*************************************************************************
+scratchArenaBytes - Estimates the scratch memory of a solve: the super
+graph, its reduction and its adjacent arcs, the workspace, the source sets
+of the initial problems and the graph and structures of one subproblem
+solve. Only the problem being solved has a graph, and it never has more
+nodes or arcs than the super graph.
+*************************************************************************/
+{
+	size_t n = ctx->numNodesSuper;
+	size_t m = ctx->numArcsSuper;
+	size_t problemBytes = n * (sizeof(Node) + sizeof(int)) + 2 * sizeof(uint) + m * sizeof(Arc);
+	size_t solveBytes = (n + 1 + 2 * m) * sizeof(uint) + n * (sizeof(Root) + sizeof(uint)) + m * sizeof(Arc);
+	/* the reduced super graph is kept next to the one that was read */
+	size_t reduceBytes = ctx->reduceGraph ? (m + 1) * (sizeof(Arc) + 2 * sizeof(double)) + 2 * ctx->numWordsSuper * sizeof(ullint) : 0;
+
+	return reduceBytes + m * (sizeof(Arc) + 2 * sizeof(double)) + (n + 1 + 2 * m) * sizeof(uint) + 3 * n * sizeof(int) + 3 * ctx->numWordsSuper * sizeof(ullint) + problemBytes + solveBytes + 32 * ARENA_ALIGN;
+}
+
+static size_t resultsArenaBytes(hpf_context *ctx)
+/*************************************************************************
+resultsArenaBytes - Estimates the cuts and flows kept by a recursion of
+depth 8. The arena grows if the recursion is deeper.
+*************************************************************************/
+{
+	size_t m = ctx->numArcsSuper;
+	size_t depth = 8;
+	size_t bytes = (2 + 3 * depth) * ctx->numWordsSuper * sizeof(ullint) + 32 * ARENA_ALIGN;
+
+	if (ctx->warmStart)
+	{
+		bytes += (2 + 2 * depth) * m * sizeof(double);
+	}
+	else if (ctx->previousLow != NULL || ctx->sweepLambdas != NULL)
+	{
+		bytes += 2 * m * sizeof(double);
+	}
+
+	return bytes;
+}
+
+static void createWorkspace(hpf_context *ctx)
+/*************************************************************************
+createWorkspace - Allocates the workspace of contractProblem
+*************************************************************************/
+{
+	ctx->nodeMap = (int *)arenaAlloc(&ctx->scratch, ctx->numNodesSuper * sizeof(int));
+	ctx->sourceAdjacentArcIndices = (int *)arenaAlloc(&ctx->scratch, ctx->numNodesSuper * sizeof(int));
+	ctx->sinkAdjacentArcIndices = (int *)arenaAlloc(&ctx->scratch, ctx->numNodesSuper * sizeof(int));
+}
+
+static void parametricCut(hpf_context *ctx, CutProblem *lowProblem, CutProblem *highProblem);
+
+#ifndef HPF_NO_THREADS
+static hpf_context * createWorkerContext(hpf_context *ctx)
+/*************************************************************************
+createWorkerContext - Creates a context that shares the super graph of ctx
+but has its own solver state, counters and breakpoints
+*************************************************************************/
+{
+	hpf_context *worker;
+
+	if ((worker = (hpf_context *)malloc(sizeof(hpf_context))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+
+	*worker = *ctx;
+
+	worker->nodesList = NULL;
+	worker->strongRoots = NULL;
+	worker->labelCount = NULL;
+	worker->arcList = NULL;
+	worker->outOfTreeStart = NULL;
+	worker->outOfTreeArcs = NULL;
+
+	worker->numArcScans = 0;
+	worker->numPushes = 0;
+	worker->numMergers = 0;
+	worker->numRelabels = 0;
+	worker->numGaps = 0;
+	worker->numWarmStarts = 0;
+	worker->numWarmStartArcs = 0;
+	worker->numBucketScans = 0;
+	worker->numGlobalUpdates = 0;
+	worker->numSubproblems = 0;
+	worker->numExactSubproblems = 0;
+#ifndef HPF_NO_PROFILE
+	/* the worker continues at the level of ctx */
+	memset(worker->phaseTimes, 0, sizeof worker->phaseTimes);
+	worker->levels = NULL;
+	worker->numLevels = 0;
+	worker->levelCapacity = 0;
+#endif
+
+	worker->firstBreakpoint = NULL;
+	worker->lastBreakpoint = NULL;
+	/* only the context of the solve passes breakpoints on */
+	worker->breakpointCallback = NULL;
+	worker->previousLow = NULL;
+	worker->previousHigh = NULL;
+	worker->sweepLambdas = NULL;
+	worker->rangeCuts = NULL;
+
+	worker->scratch.first = NULL;
+	worker->scratch.current = NULL;
+	worker->scratch.capacity = 0;
+	worker->results.first = NULL;
+	worker->results.current = NULL;
+	worker->results.capacity = 0;
+	arenaReserve(&worker->scratch, scratchArenaBytes(ctx));
+	arenaReserve(&worker->results, resultsArenaBytes(ctx));
+	createWorkspace(worker);
+
+	return worker;
+}
+
+static void mergeWorkerContext(hpf_context *ctx, hpf_context *worker)
+/*************************************************************************
+mergeWorkerContext - Appends the breakpoints of worker to those of ctx,
+passes them on if ctx has a callback, adds up the counters and releases
+worker
+*************************************************************************/
+{
+	Breakpoint *breakpoint;
+#ifndef HPF_NO_PROFILE
+	uint i;
+#endif
+
+	ctx->numArcScans += worker->numArcScans;
+	ctx->numPushes += worker->numPushes;
+	ctx->numMergers += worker->numMergers;
+	ctx->numRelabels += worker->numRelabels;
+	ctx->numGaps += worker->numGaps;
+	ctx->numWarmStarts += worker->numWarmStarts;
+	ctx->numWarmStartArcs += worker->numWarmStartArcs;
+	ctx->numBucketScans += worker->numBucketScans;
+	ctx->numGlobalUpdates += worker->numGlobalUpdates;
+	ctx->numSubproblems += worker->numSubproblems;
+	ctx->numExactSubproblems += worker->numExactSubproblems;
+#ifndef HPF_NO_PROFILE
+	for (i = 0; i < NUM_PHASES; i++)
+	{
+		ctx->phaseTimes[i] += worker->phaseTimes[i];
+	}
+	if (worker->numLevels > ctx->levelCapacity)
+	{
+		ctx->levelCapacity = worker->numLevels;
+		if ((ctx->levels = (LevelStats *)realloc(ctx->levels, ctx->levelCapacity * sizeof(LevelStats))) == NULL)
+		{
+			printf("Could not allocate memory.\n");
+			exit(0);
+		}
+	}
+	for (; ctx->numLevels < worker->numLevels; ++ ctx->numLevels)
+	{
+		memset(&ctx->levels[ctx->numLevels], 0, sizeof(LevelStats));
+	}
+	for (i = 0; i < worker->numLevels; i++)
+	{
+		ctx->levels[i].numProblems += worker->levels[i].numProblems;
+		ctx->levels[i].numNodes += worker->levels[i].numNodes;
+		ctx->levels[i].numArcs += worker->levels[i].numArcs;
+	}
+	free(worker->levels);
+#endif
+
+	if (worker->firstBreakpoint != NULL && ctx->isSearchStopped)
+	{
+		/* the breakpoints are beyond the one that stopped the search */
+		destroyBreakpoint(worker->firstBreakpoint);
+	}
+	else if (worker->firstBreakpoint != NULL)
+	{
+		if (ctx->lastBreakpoint == NULL)
+		{
+			ctx->firstBreakpoint = worker->firstBreakpoint;
+		}
+		else
+		{
+			ctx->lastBreakpoint->next = worker->firstBreakpoint;
+		}
+		ctx->lastBreakpoint = worker->lastBreakpoint;
+
+		for (breakpoint = worker->firstBreakpoint; breakpoint != NULL; breakpoint = breakpoint->next)
+		{
+			emitBreakpoint(ctx, breakpoint);
+			if (ctx->isSearchStopped)
+			{
+				destroyBreakpoint(breakpoint->next);
+				breakpoint->next = NULL;
+				ctx->lastBreakpoint = breakpoint;
+				break;
+			}
+		}
+	}
+
+	arenaFree(&worker->scratch);
+	arenaFree(&worker->results);
+	free(worker);
+}
+#endif
+
+#ifndef HPF_NO_THREADS
+typedef struct ParametricTask
+{
+	hpf_context *ctx;
+	CutProblem *lowProblem;
+	CutProblem *highProblem;
+} ParametricTask;
+
+static int acquireThread(TaskPool *pool)
+/*************************************************************************
+acquireThread - Claims an idle thread from the pool, if there is one
+*************************************************************************/
+{
+	int acquired = 0;
+
+	pthread_mutex_lock(&pool->lock);
+	if (pool->idleThreads > 0)
+	{
+		-- pool->idleThreads;
+		acquired = 1;
+	}
+	pthread_mutex_unlock(&pool->lock);
+
+	return acquired;
+}
+
+static void releaseThread(TaskPool *pool)
+/*************************************************************************
+releaseThread - Returns a thread to the pool
+*************************************************************************/
+{
+	pthread_mutex_lock(&pool->lock);
+	++ pool->idleThreads;
+	pthread_mutex_unlock(&pool->lock);
+}
+
+static void * parametricCutTask(void *arg)
+/*************************************************************************
+parametricCutTask - Thread entry point for a subinterval
+*************************************************************************/
+{
+	ParametricTask *task = (ParametricTask *)arg;
+
+	parametricCut(task->ctx, task->lowProblem, task->highProblem);
+	releaseThread(task->ctx->taskPool);
+
+	return NULL;
+}
+#endif
+
+static void startTaskPool(hpf_context *ctx, TaskPool *pool)
+/*************************************************************************
+startTaskPool - Makes numThreads - 1 additional threads available to the
+breakpoint search
+*************************************************************************/
+{
+	ctx->taskPool = NULL;
+
+#ifndef HPF_NO_THREADS
+	if (ctx->numThreads > 1)
+	{
+		pthread_mutex_init(&pool->lock, NULL);
+		pool->idleThreads = ctx->numThreads - 1;
+		pool->isStopped = 0;
+		ctx->taskPool = pool;
+	}
+#endif
+}
+
+static void stopTaskPool(hpf_context *ctx)
+/*************************************************************************
+stopTaskPool - Releases the pool created by startTaskPool
+*************************************************************************/
+{
+#ifndef HPF_NO_THREADS
+	if (ctx->taskPool != NULL)
+	{
+		pthread_mutex_destroy(&ctx->taskPool->lock);
+	}
+#endif
+	ctx->taskPool = NULL;
+}
+
+static void parametricCutSubintervals(hpf_context *ctx, CutProblem *lowProblem, CutProblem *minimalIntersect, CutProblem *maximalIntersect, CutProblem *highProblem, int isBreakpoint, double lambdaIntersect)
+/*************************************************************************
+parametricCutSubintervals - Recurses on [low, minimalIntersect] and
+[maximalIntersect, high], and adds the breakpoint at lambdaIntersect in
+between if isBreakpoint is set. The higher subinterval is handed to another
+thread if one is idle. Its breakpoints are collected separately and
+appended afterwards, so the breakpoints remain sorted by lambda.
+*************************************************************************/
+{
+#ifndef HPF_NO_THREADS
+	if (ctx->taskPool != NULL && maximalIntersect->numNodesInList >= PARALLEL_MIN_NODES && acquireThread(ctx->taskPool))
+	{
+		pthread_t thread;
+		ParametricTask task;
+
+		task.ctx = createWorkerContext(ctx);
+		task.lowProblem = maximalIntersect;
+		task.highProblem = highProblem;
+
+		if (pthread_create(&thread, NULL, parametricCutTask, &task) == 0)
+		{
+			parametricCut(ctx, lowProblem, minimalIntersect);
+			if (isBreakpoint)
+			{
+				addBreakpoint(ctx, lambdaIntersect, minimalIntersect->optimalSourceSetIndicator);
+			}
+			pthread_join(thread, NULL);
+			mergeWorkerContext(ctx, task.ctx);
+			return;
+		}
+
+		/* could not start a thread: solve sequentially */
+		releaseThread(ctx->taskPool);
+		mergeWorkerContext(ctx, task.ctx);
+	}
+#endif
+
+	parametricCut(ctx, lowProblem, minimalIntersect);
+	if (isBreakpoint)
+	{
+		addBreakpoint(ctx, lambdaIntersect, minimalIntersect->optimalSourceSetIndicator);
+	}
+	parametricCut(ctx, maximalIntersect, highProblem);
+}
+
+static void parametricCut(hpf_context *ctx, CutProblem *lowProblem, CutProblem *highProblem)
+/*************************************************************************
+parametricCut - Recursive function that solves the parametric cut problem
+*************************************************************************/
+{
+	// print low, high + breakpoints
+	// printf("Lambda High: %.4f\nLambda Low: %.4f\n",highProblem->lambdaValue, lowProblem->lambdaValue);
+
+    if (isSearchStopped(ctx))
+    {
+        return;
+    }
+
+    // cuts and flows of this call are released on return
+    ArenaMark resultsMark = arenaMark(&ctx->results);
+#ifndef HPF_NO_PROFILE
+    ++ ctx->recursionLevel;
+#endif
+
+    // determine difference between source sets of cut.
+    ullint *pdifference_low_high;
+    uint num_nodes_different_low_high = differenceSourceSets(ctx, &pdifference_low_high, lowProblem->optimalSourceSetIndicator, highProblem->optimalSourceSetIndicator);
+
+	/* find lambda value for which the optimal cut functions(expressed as a function of lambda) for the lower bound and upper bound problem intersect. */
+	if (num_nodes_different_low_high > 0)
+	{
+        // find intersection using method outlined in Hochbaum 2003 on inverse spanning-tree.
+        llint numerator, denominator, spread;
+        double lambdaIntersect = computeIntersect(ctx, lowProblem->optimalSourceSetIndicator, highProblem->optimalSourceSetIndicator, pdifference_low_high, &numerator, &denominator, &spread);
+
+        // printf("Intersect: %lf\n", lambdaIntersect);
+
+        // find minimal and maximal source set at lambdaIntersect.
+        // Add/subtract TOL to prevent numerical issues. Within TOL of an end
+        // of the range, the problem at that end is optimal at lambdaIntersect.
+        // Solving there instead could return the other cut of a breakpoint
+        // at the end and repeat the same interval forever.
+        // With integral capacities, lambdaIntersect is numerator / denominator
+        // and no other breakpoint is closer to it than
+        // 1 / (denominator * spread), so the problems are solved exactly at
+        // a distance of 1 / (denominator * (spread + 1)) instead.
+        llint scale = spread + 1;
+        uint isExact = (denominator > 0 && isExactLambda(ctx, (double) numerator * (double) scale, (double) denominator * (double) scale));
+
+        CutProblem minimalIntersect;
+        if (isExact ? lambdaIntersect <= ctx->LAMBDA_LOW : lambdaIntersect - TOL < ctx->LAMBDA_LOW)
+        {
+            minimalIntersect = *lowProblem;
+        }
+        else
+        {
+            initializeContractedProblem(ctx, &minimalIntersect, lambdaIntersect - TOL, lowProblem->optimalSourceSetIndicator, highProblem->optimalSourceSetIndicator);
+            if (isExact)
+            {
+                setExactLambda(&minimalIntersect, numerator * scale - 1, denominator * scale);
+            }
+
+            solveProblem(ctx, &minimalIntersect, 0, lowProblem);
+            destroyProblem(&minimalIntersect, 0);
+        }
+
+		CutProblem maximalIntersect;
+        if (isExact ? lambdaIntersect >= ctx->LAMBDA_HIGH : lambdaIntersect + TOL > ctx->LAMBDA_HIGH)
+        {
+            maximalIntersect = *highProblem;
+        }
+        else
+        {
+            initializeContractedProblem(ctx, &maximalIntersect, lambdaIntersect + TOL, minimalIntersect.optimalSourceSetIndicator, highProblem->optimalSourceSetIndicator);
+            if (isExact)
+            {
+                setExactLambda(&maximalIntersect, numerator * scale + 1, denominator * scale);
+            }
+
+            solveProblem(ctx, &maximalIntersect, 0, &minimalIntersect);
+            destroyProblem(&maximalIntersect, 0);
+        }
+
+        // check if lambdaIntersect is a breakpoint by comparing min and max source set.
+        uint num_nodes_different_min_max = countDifference(ctx, minimalIntersect.optimalSourceSetIndicator, maximalIntersect.optimalSourceSetIndicator);
+
+        // If they differ, the intersection is a breakpoint. There can be
+        // more breakpoints on either side unless the minimal and maximal
+        // source sets are those of the low and high problems, in which case
+        // the recursion stops at once. Otherwise the intersection separates
+        // two breakpoints. Recurse.
+        /* recurse for lower and higher subinterval */
+        parametricCutSubintervals(ctx, lowProblem, &minimalIntersect, &maximalIntersect, highProblem, num_nodes_different_min_max > 0, lambdaIntersect);
+
+        /* call destructor function */
+        destroyProblem(&minimalIntersect, 1);
+        destroyProblem(&maximalIntersect, 1);
+
+	}
+    else
+    {
+        // printf("Stop recursion: Same cuts!\n");
+    }
+#ifndef HPF_NO_PROFILE
+    -- ctx->recursionLevel;
+#endif
+    arenaRewind(&ctx->results, resultsMark);
+}
+
+static void sweepLambdas(hpf_context *ctx)
+/*************************************************************************
+sweepLambdas - Solves the cut problem for every lambda of a sorted list.
+The largest lambda is solved first, and its sink set is contracted into
+the sink of all other problems. These are solved in increasing order of
+lambda, each with the source set of the one before contracted into the
+source and starting from its flows.
+*************************************************************************/
+{
+	uint k, last;
+	CutProblem problem, previous;
+	ullint *lowSourceSet, *highSourceSet;
+	ArenaMark resultsMark;
+
+	if (ctx->numSweepLambdas == 0)
+	{
+		return;
+	}
+	last = ctx->numSweepLambdas - 1;
+
+	lowSourceSet = (ullint *)arenaAlloc(&ctx->scratch, ctx->numWordsSuper * sizeof(ullint));
+	highSourceSet = (ullint *)arenaAlloc(&ctx->scratch, ctx->numWordsSuper * sizeof(ullint));
+	previous.lowSourceSet = (ullint *)arenaAlloc(&ctx->scratch, ctx->numWordsSuper * sizeof(ullint));
+	previous.highSourceSet = (ullint *)arenaAlloc(&ctx->scratch, ctx->numWordsSuper * sizeof(ullint));
+	previous.interiorArcFlow = (double *)arenaAlloc(&ctx->scratch, (ctx->numArcsSuper + 1) * sizeof(double));
+	previous.solved = 0;
+	initialSourceSets(ctx, lowSourceSet, highSourceSet);
+
+	resultsMark = arenaMark(&ctx->results);
+	initializeContractedProblem(ctx, &problem, ctx->sweepLambdas[last], lowSourceSet, highSourceSet);
+	solveProblem(ctx, &problem, 0, NULL);
+	/* the contraction is kept before its source sets change */
+	keepFlows(ctx, &previous, &problem);
+	memcpy(highSourceSet, problem.optimalSourceSetIndicator, ctx->numWordsSuper * sizeof(ullint));
+	destroyProblem(&problem, 1);
+	arenaRewind(&ctx->results, resultsMark);
+
+	for (k = 0; k < last && !isSearchStopped(ctx); ++k)
+	{
+		initializeContractedProblem(ctx, &problem, ctx->sweepLambdas[k], lowSourceSet, highSourceSet);
+		solveProblem(ctx, &problem, 0, previous.solved ? &previous : NULL);
+		if (problem.interiorArcFlow != NULL)
+		{
+			keepFlows(ctx, &previous, &problem);
+		}
+		memcpy(lowSourceSet, problem.optimalSourceSetIndicator, ctx->numWordsSuper * sizeof(ullint));
+		destroyProblem(&problem, 1);
+		arenaRewind(&ctx->results, resultsMark);
+
+		addBreakpoint(ctx, ctx->sweepLambdas[k], lowSourceSet);
+	}
+
+	addBreakpoint(ctx, ctx->sweepLambdas[last], highSourceSet);
+}
+
+static void restoreGraphSuper(hpf_context *ctx, const ArcInput *input, int numArcsIn)
+/*************************************************************************
+restoreGraphSuper - Reads the super graph again if reduceGraphSuper has
+reduced it, so that the cut values and flows are those of all arcs of the
+input
+*************************************************************************/
+{
+	if (ctx->fixedSourceSet == NULL)
+	{
+		return;
+	}
+
+	ctx->numArcsSuper = (uint) numArcsIn;
+	ctx->fixedSourceSet = NULL;
+	ctx->fixedSinkSet = NULL;
+	readGraphSuper(ctx, input);
+	checkIntegralCapacities(ctx);
+}
+
+static void solveFlows(hpf_context *ctx)
+/*************************************************************************
+solveFlows - Solves the problem at flowLambda with no node contracted and
+keeps the maximum flow of every arc in arcFlows
+*************************************************************************/
+{
+	CutProblem problem;
+	ullint *lowSourceSet, *highSourceSet;
+	ArenaMark resultsMark = arenaMark(&ctx->results);
+
+	if ((ctx->arcFlows = (double *)malloc((ctx->numArcsSuper + 1) * sizeof(double))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+
+	lowSourceSet = (ullint *)arenaAlloc(&ctx->scratch, ctx->numWordsSuper * sizeof(ullint));
+	highSourceSet = (ullint *)arenaAlloc(&ctx->scratch, ctx->numWordsSuper * sizeof(ullint));
+	initialSourceSets(ctx, lowSourceSet, highSourceSet);
+
+	initializeContractedProblem(ctx, &problem, ctx->flowLambda, lowSourceSet, highSourceSet);
+	problem.keepInteriorFlows = 0;
+	problem.superArcFlow = ctx->arcFlows;
+	solveProblem(ctx, &problem, 0, NULL);
+	destroyProblem(&problem, 1);
+	arenaRewind(&ctx->results, resultsMark);
+}
+
+static void freeSolveOutputs(hpf_context *ctx)
+/*************************************************************************
+freeSolveOutputs - Releases the cut values and flows of the last solve
+*************************************************************************/
+{
+	free(ctx->cutValues);
+	free(ctx->arcFlows);
+	ctx->cutValues = NULL;
+	ctx->arcFlows = NULL;
+}
+
+static void resetContext(hpf_context *ctx)
+/*************************************************************************
+resetContext - Restores the initial state of a solver context
+*************************************************************************/
+{
+	ctx->numNodes = 0;
+	ctx->numArcs = 0;
+	ctx->numNodesSuper = 0;
+	ctx->numArcsSuper = 0;
+	ctx->numWordsSuper = 0;
+	ctx->source = 0;
+	ctx->sourceSuper = 0;
+	ctx->sink = 0;
+	ctx->sinkSuper = 0;
+	ctx->highestStrongLabel = 1;
+
+	ctx->numArcScans = 0;
+	ctx->numPushes = 0;
+	ctx->numMergers = 0;
+	ctx->numRelabels = 0;
+	ctx->numGaps = 0;
+	ctx->numWarmStarts = 0;
+	ctx->numWarmStartArcs = 0;
+	ctx->numBucketScans = 0;
+	ctx->numGlobalUpdates = 0;
+	ctx->numFixedNodes = 0;
+	ctx->numRemovedArcs = 0;
+	ctx->numSubproblems = 0;
+	ctx->numExactSubproblems = 0;
+	ctx->integralCapacities = 0;
+	ctx->constantSum = 0;
+	ctx->multiplierSum = 0;
+#ifndef HPF_NO_PROFILE
+	memset(ctx->phaseTimes, 0, sizeof ctx->phaseTimes);
+	ctx->numLevels = 0;
+	ctx->recursionLevel = 0;
+#endif
+
+	ctx->nodesList = NULL;
+	ctx->strongRoots = NULL;
+	ctx->activeLabels = NULL;
+	ctx->activeLabelWords = NULL;
+	ctx->labelCount = NULL;
+	ctx->arcList = NULL;
+	ctx->outOfTreeStart = NULL;
+	ctx->outOfTreeArcs = NULL;
+	ctx->arcListSuper = NULL;
+	ctx->constantSuper = NULL;
+	ctx->multiplierSuper = NULL;
+	ctx->adjacentStartSuper = NULL;
+	ctx->adjacentArcsSuper = NULL;
+	ctx->fixedSourceSet = NULL;
+	ctx->fixedSinkSet = NULL;
+	ctx->lowestPositiveExcessNode = 0;
+
+	ctx->lastBreakpoint = NULL;
+	ctx->firstBreakpoint = NULL;
+	ctx->numEmittedBreakpoints = 0;
+	ctx->packedSourceSet = NULL;
+	ctx->emittedSourceSet = NULL;
+	ctx->addedNodes = NULL;
+	ctx->emittedIndices = NULL;
+	ctx->isSearchStopped = 0;
+
+	ctx->useParametricCut = 1;
+	ctx->roundNegativeCapacity = 0;
+
+	ctx->LAMBDA_LOW = 0;
+	ctx->LAMBDA_HIGH = 0;
+
+	ctx->taskPool = NULL;
+
+	ctx->nodeMap = NULL;
+	ctx->sourceAdjacentArcIndices = NULL;
+	ctx->sinkAdjacentArcIndices = NULL;
+}
+
+hpf_context * hpf_context_create(void)
+/*************************************************************************
+hpf_context_create - Allocates a solver context
+*************************************************************************/
+{
+	hpf_context *ctx;
+
+	if ((ctx = (hpf_context *)malloc(sizeof(hpf_context))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+
+	resetContext(ctx);
+	ctx->scratch.first = NULL;
+	ctx->scratch.current = NULL;
+	ctx->scratch.capacity = 0;
+	ctx->results.first = NULL;
+	ctx->results.current = NULL;
+	ctx->results.capacity = 0;
+	ctx->previousLow = NULL;
+	ctx->previousHigh = NULL;
+	ctx->sweepLambdas = NULL;
+	ctx->numSweepLambdas = 0;
+	ctx->rangeCuts = NULL;
+	ctx->numRangeCutNodes = 0;
+#ifndef HPF_NO_PROFILE
+	ctx->levels = NULL;
+	ctx->levelCapacity = 0;
+#endif
+	ctx->numThreads = 1;
+	ctx->numRegionThreads = 1;
+	ctx->warmStart = 0;
+	ctx->globalUpdate = 0;
+	ctx->reduceGraph = 0;
+	ctx->exactCapacities = 1;
+	ctx->computeCutValues = 0;
+	ctx->hasFlowLambda = 0;
+	ctx->flowLambda = 0;
+	ctx->cutValues = NULL;
+	ctx->arcFlows = NULL;
+	ctx->cutFormat = HPF_CUTS_DENSE;
+	ctx->breakpointCallback = NULL;
+	ctx->callbackData = NULL;
+
+	return ctx;
+}
+
+void hpf_context_set_option(hpf_context *ctx, hpf_option option, int value)
+/*************************************************************************
+hpf_context_set_option - Changes a setting of ctx for subsequent solves
+*************************************************************************/
+{
+	switch (option)
+	{
+	case HPF_OPTION_NUM_THREADS:
+		if (value < 1)
+		{
+			printf("The number of threads should be at least 1.\n");
+			exit(0);
+		}
+		ctx->numThreads = (uint) value;
+		break;
+	case HPF_OPTION_REGION_THREADS:
+		if (value < 1)
+		{
+			printf("The number of region threads should be at least 1.\n");
+			exit(0);
+		}
+		ctx->numRegionThreads = (uint) value;
+		break;
+	case HPF_OPTION_WARM_START:
+		ctx->warmStart = (value != 0);
+		break;
+	case HPF_OPTION_GLOBAL_UPDATE:
+		if (value < 0)
+		{
+			printf("The work between global updates should not be negative.\n");
+			exit(0);
+		}
+		ctx->globalUpdate = (uint) value;
+		break;
+	case HPF_OPTION_REDUCE_GRAPH:
+		ctx->reduceGraph = (value != 0);
+		break;
+	case HPF_OPTION_EXACT_CAPACITIES:
+		ctx->exactCapacities = (value != 0);
+		break;
+	case HPF_OPTION_CUT_VALUES:
+		ctx->computeCutValues = (value != 0);
+		break;
+	case HPF_OPTION_CUT_FORMAT:
+		if (value < HPF_CUTS_DENSE || value > HPF_CUTS_INDEX)
+		{
+			printf("Unknown cut format: %d\n", value);
+			exit(0);
+		}
+		ctx->cutFormat = (uint) value;
+		break;
+	default:
+		printf("Unknown option: %d\n", (int) option);
+		exit(0);
+	}
+}
+
+void hpf_context_set_callback(hpf_context *ctx, hpf_breakpoint_callback callback, void *userData)
+/*************************************************************************
+hpf_context_set_callback - Sets the breakpoint callback of ctx
+*************************************************************************/
+{
+	ctx->breakpointCallback = callback;
+	ctx->callbackData = userData;
+}
+
+void hpf_context_set_flow_lambda(hpf_context *ctx, const double *lambda)
+/*************************************************************************
+hpf_context_set_flow_lambda - Sets the lambda of the flows of subsequent
+solves of ctx, or clears it if lambda is NULL
+*************************************************************************/
+{
+	ctx->hasFlowLambda = (lambda != NULL);
+	ctx->flowLambda = (lambda != NULL) ? *lambda : 0;
+}
+
+void hpf_context_set_range_cuts(hpf_context *ctx, int numNodes, const unsigned int *lowSourceSet, const unsigned int *highSourceSet)
+/*************************************************************************
+hpf_context_set_range_cuts - Keeps copies of the source sets at both ends
+of the lambda range for the next solves of ctx
+*************************************************************************/
+{
+	int numWords = HPF_CUT_WORDS(numNodes);
+
+	free(ctx->rangeCuts);
+	ctx->rangeCuts = NULL;
+	ctx->numRangeCutNodes = 0;
+	if (lowSourceSet == NULL || highSourceSet == NULL)
+	{
+		return;
+	}
+
+	if ((ctx->rangeCuts = (unsigned int *)malloc((2 * numWords + 1) * sizeof(unsigned int))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+	memcpy(ctx->rangeCuts, lowSourceSet, numWords * sizeof(unsigned int));
+	memcpy(ctx->rangeCuts + numWords, highSourceSet, numWords * sizeof(unsigned int));
+	ctx->numRangeCutNodes = numNodes;
+}
+
+unsigned long long hpf_context_get_stat(hpf_context *ctx, hpf_stat stat)
+/*************************************************************************
+hpf_context_get_stat - Returns a counter of the last solve of ctx
+*************************************************************************/
+{
+	switch (stat)
+	{
+	case HPF_STAT_NUM_ARC_SCANS:
+		return ctx->numArcScans;
+	case HPF_STAT_NUM_MERGERS:
+		return ctx->numMergers;
+	case HPF_STAT_NUM_PUSHES:
+		return ctx->numPushes;
+	case HPF_STAT_NUM_RELABELS:
+		return ctx->numRelabels;
+	case HPF_STAT_NUM_GAPS:
+		return ctx->numGaps;
+	case HPF_STAT_NUM_WARM_STARTS:
+		return ctx->numWarmStarts;
+	case HPF_STAT_NUM_WARM_START_ARCS:
+		return ctx->numWarmStartArcs;
+	case HPF_STAT_NUM_BUCKET_SCANS:
+		return ctx->numBucketScans;
+	case HPF_STAT_NUM_GLOBAL_UPDATES:
+		return ctx->numGlobalUpdates;
+	case HPF_STAT_NUM_FIXED_NODES:
+		return ctx->numFixedNodes;
+	case HPF_STAT_NUM_REMOVED_ARCS:
+		return ctx->numRemovedArcs;
+	case HPF_STAT_NUM_SUBPROBLEMS:
+		return ctx->numSubproblems;
+	case HPF_STAT_NUM_EXACT_SUBPROBLEMS:
+		return ctx->numExactSubproblems;
+	case HPF_STAT_NUM_LEVELS:
+#ifndef HPF_NO_PROFILE
+		return ctx->numLevels;
+#else
+		return 0;
+#endif
+	default:
+		printf("Unknown statistic: %d\n", (int) stat);
+		exit(0);
+	}
+}
+
+double hpf_context_get_phase_time(hpf_context *ctx, hpf_phase phase)
+/*************************************************************************
+hpf_context_get_phase_time - Returns the time of the last solve of ctx in a
+phase of the subproblems
+*************************************************************************/
+{
+	if ((int) phase < 0 || (int) phase >= NUM_PHASES)
+	{
+		printf("Unknown phase: %d\n", (int) phase);
+		exit(0);
+	}
+#ifndef HPF_NO_PROFILE
+	return ctx->phaseTimes[phase];
+#else
+	return 0;
+#endif
+}
+
+void hpf_context_get_level(hpf_context *ctx, int level, unsigned long long *numProblems, unsigned long long *numNodes, unsigned long long *numArcs)
+/*************************************************************************
+hpf_context_get_level - Returns the subproblems of the last solve of ctx at
+a level of the recursion
+*************************************************************************/
+{
+	if (level < 0 || (ullint) level >= hpf_context_get_stat(ctx, HPF_STAT_NUM_LEVELS))
+	{
+		printf("Unknown level: %d\n", level);
+		exit(0);
+	}
+#ifndef HPF_NO_PROFILE
+	*numProblems = ctx->levels[level].numProblems;
+	*numNodes = ctx->levels[level].numNodes;
+	*numArcs = ctx->levels[level].numArcs;
+#endif
+}
+
+const double * hpf_context_get_cut_values(hpf_context *ctx)
+/*************************************************************************
+hpf_context_get_cut_values - The cut value of every breakpoint of the last
+solve of ctx, or NULL
+*************************************************************************/
+{
+	return ctx->cutValues;
+}
+
+const double * hpf_context_get_flows(hpf_context *ctx)
+/*************************************************************************
+hpf_context_get_flows - The flow of every arc at the flow lambda of the
+last solve of ctx, or NULL
+*************************************************************************/
+{
+	return ctx->arcFlows;
+}
+
+void hpf_context_destroy(hpf_context *ctx)
+/*************************************************************************
+hpf_context_destroy - Releases a solver context and all memory it owns
+*************************************************************************/
+{
+	if (ctx == NULL)
+	{
+		return;
+	}
+
+	freeMemoryComplete(ctx);
+	freeSolveOutputs(ctx);
+	arenaFree(&ctx->scratch);
+	arenaFree(&ctx->results);
+	free(ctx->rangeCuts);
+#ifndef HPF_NO_PROFILE
+	free(ctx->levels);
+#endif
+	free(ctx);
+}
+
+static void solveInput(hpf_context *ctx, int numNodesIn, int numArcsIn, int sourceIn, int sinkIn, const ArcInput *input, double lambdaRange[2], int roundNegativeCapacityIn, int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5], double times[3] )
+/*************************************************************************
+solveInput - Solves a parametric cut problem using the state in ctx
+*************************************************************************/
+{
+	freeMemoryComplete(ctx);
+	freeSolveOutputs(ctx);
+	resetContext(ctx);
+
+	double readStart, readEnd, initStart, initEnd, solveStart, solveEnd;
+
+	// printf("NumNodes: %d\n", numNodesIn);
+	// printf("NumArcs: %d\n", numArcsIn);
+	// printf("Lambda Range: [%lf, %lf]\n", lambdaRange[0], lambdaRange[1]);
+	// printf("Round if negative: %d\n", roundNegativeCapacity);
+	// printf("Arc matrix:\n");
+	// for (int i = 0; i < numArcsIn; ++i)
+	// {
+	// 	printf("Row %d: [%.2lf, %.2lf, %.2lf, %.2lf]\n", i, arcMatrix[i * 4 + 0 ], arcMatrix[i * 4 + 1 ], arcMatrix[i * 4 + 2 ], arcMatrix[i * 4 + 3 ]);
+	// }
+
+	readStart = wallTime();
+	// readInput
+	ctx->numNodesSuper = numNodesIn;
+	ctx->numArcsSuper = numArcsIn;
+	ctx->numWordsSuper = (ctx->numNodesSuper + WORD_BITS - 1) / WORD_BITS;
+	ctx->sourceSuper = (uint) sourceIn;
+	ctx->sinkSuper = (uint) sinkIn;
+	ctx->LAMBDA_LOW = lambdaRange[0];
+	ctx->LAMBDA_HIGH = lambdaRange[1];
+	ctx->roundNegativeCapacity = roundNegativeCapacityIn;
+	if (ctx->rangeCuts != NULL && ctx->numRangeCutNodes != numNodesIn)
+	{
+		printf("The cuts at the ends of the range have %d nodes, but the graph has %d.\n", ctx->numRangeCutNodes, numNodesIn);
+		exit(0);
+	}
+	arenaReserve(&ctx->scratch, scratchArenaBytes(ctx));
+	arenaReserve(&ctx->results, resultsArenaBytes(ctx));
+	readGraphSuper(ctx, input);
+	if (ctx->reduceGraph && ctx->previousLow == NULL)
+	{
+		/* the kept flows of a graph handle are numbered by its arcs */
+		reduceGraphSuper(ctx);
+	}
+	checkIntegralCapacities(ctx);
+	if (ctx->breakpointCallback != NULL)
+	{
+		ctx->packedSourceSet = (unsigned int *)arenaAlloc(&ctx->scratch, HPF_CUT_WORDS(numNodesIn) * sizeof(unsigned int));
+		ctx->emittedSourceSet = (ullint *)arenaAlloc(&ctx->scratch, ctx->numWordsSuper * sizeof(ullint));
+		ctx->addedNodes = (int *)arenaAlloc(&ctx->scratch, ctx->numNodesSuper * sizeof(int));
+		memset(ctx->emittedSourceSet, 0, ctx->numWordsSuper * sizeof(ullint));
+		if (ctx->computeCutValues)
+		{
+			ctx->emittedIndices = (int *)arenaAlloc(&ctx->scratch, ctx->numNodesSuper * sizeof(int));
+			memset(ctx->emittedIndices, -1, ctx->numNodesSuper * sizeof(int));
+		}
+	}
+	readEnd = wallTime();
+
+	initStart = wallTime();
+	CutProblem lowProblem;
+	CutProblem highProblem;
+	createWorkspace(ctx);
+	createAdjacentArcsSuper(ctx);
+	if (ctx->sweepLambdas == NULL)
+	{
+		initializeParametricCut(ctx, &lowProblem,&highProblem);
+	}
+	if (ctx->previousLow != NULL)
+	{
+		/* the flows at both ends are kept for the next solve */
+		lowProblem.keepInteriorFlows = 1;
+		if (ctx->useParametricCut == 1)
+		{
+			highProblem.keepInteriorFlows = 1;
+		}
+	}
+	initEnd = wallTime();
+
+	solveStart = wallTime();
+	if (ctx->sweepLambdas != NULL)
+	{
+		sweepLambdas(ctx);
+	}
+	else if (ctx->useParametricCut == 1 && ctx->rangeCuts != NULL)
+	{
+        // the cuts at both ends are given, only the range between them is searched
+        unpackSourceSet(ctx, ctx->rangeCuts, &lowProblem);
+        unpackSourceSet(ctx, ctx->rangeCuts + HPF_CUT_WORDS(numNodesIn), &highProblem);
+        if (countDifference(ctx, highProblem.optimalSourceSetIndicator, lowProblem.optimalSourceSetIndicator) > 0)
+        {
+            printf("The source set at the low end of the range has to be contained in the source set at the high end.\n");
+            exit(0);
+        }
+
+		TaskPool taskPool;
+		startTaskPool(ctx, &taskPool);
+		parametricCut(ctx, &lowProblem, &highProblem);
+		stopTaskPool(ctx);
+
+        addBreakpoint(ctx, highProblem.lambdaValue, highProblem.optimalSourceSetIndicator);
+
+		destroyProblem(&lowProblem, 1);
+		destroyProblem(&highProblem, 1);
+	}
+	else if (ctx->useParametricCut == 1)
+	{
+        // solve lower bound problem, from the flows of the previous solve if any
+        solveProblem(ctx, &lowProblem, 0, (ctx->previousLow != NULL && ctx->previousLow->solved) ? ctx->previousLow : NULL);
+        destroyProblem(&lowProblem, 0);
+
+        // solve upper bound problem
+        solveProblem(ctx, &highProblem, 0, (ctx->previousHigh != NULL && ctx->previousHigh->solved) ? ctx->previousHigh : &lowProblem);
+        destroyProblem(&highProblem, 0);
+        if (ctx->previousLow != NULL)
+        {
+            keepFlows(ctx, ctx->previousLow, &lowProblem);
+            keepFlows(ctx, ctx->previousHigh, &highProblem);
+        }
+
+        // find breakpoints + recurse
+		TaskPool taskPool;
+		startTaskPool(ctx, &taskPool);
+		parametricCut(ctx, &lowProblem, &highProblem);
+		stopTaskPool(ctx);
+
+        // add upper bound as final breakpoint for last interval.
+        addBreakpoint(ctx, highProblem.lambdaValue, highProblem.optimalSourceSetIndicator);
+
+		/* deallocate memory */
+		destroyProblem(&lowProblem, 1);
+		destroyProblem(&highProblem, 1);
+	}
+	else
+	{
+		solveProblem(ctx, &lowProblem, 0, (ctx->previousLow != NULL && ctx->previousLow->solved) ? ctx->previousLow : NULL);
+		destroyProblem(&lowProblem, 0);
+		if (ctx->previousLow != NULL)
+		{
+			keepFlows(ctx, ctx->previousLow, &lowProblem);
+		}
+		/* add solution as breakpoint */
+		addBreakpoint(ctx, lowProblem.lambdaValue, lowProblem.optimalSourceSetIndicator);
+		/* deallocate memory */
+		destroyProblem(&lowProblem, 1);
+	}
+	if (ctx->computeCutValues || ctx->hasFlowLambda)
+	{
+		restoreGraphSuper(ctx, input, numArcsIn);
+	}
+	if (ctx->hasFlowLambda)
+	{
+		/* the flow is recovered from one more problem on the whole graph */
+		solveFlows(ctx);
+	}
+	solveEnd = wallTime();
+
+	times[0] = readEnd - readStart;
+	times[1] = initEnd - initStart;
+	times[2] = solveEnd - solveStart;
+
+	if (ctx->computeCutValues)
+	{
+		evaluateBreakpointCuts(ctx);
+	}
+	prepareOutput(ctx, numBreakpoints, cuts, breakpoints, stats);
+
+	// printf("Stats: [%d, %d, %d, %d, %d]\n", stats[0],stats[1],stats[2],stats[3],stats[4]);
+	// printf("times: [%lf, %lf, %lf]\n", times[0],times[1],times[2]);
+	// printf("Num breakpoints: %d\n", *numBreakpoints);
+	// printf("breakpoints:\n");
+	// for (int i = 0; i < *numBreakpoints; ++i)
+	// {
+	// 	printf("Breakpoint: %lf\n", (*breakpoints)[i]);
+	// 	for (int j = 0; j < (int)numNodesSuper; j++)
+	// 	{
+	// 		printf("Cut indicator: %d\n", (*cuts)[i * (int) numNodesSuper + j ]);
+	// 	}
+	// }
+
+
+	freeMemoryComplete (ctx);
+
+
+}
+
+void hpf_context_solve(hpf_context *ctx, int numNodesIn, int numArcsIn, int sourceIn, int sinkIn, double * arcMatrix, double lambdaRange[2], int roundNegativeCapacityIn, int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5], double times[3] )
+/*************************************************************************
+hpf_context_solve - Solves a parametric cut problem given as an arc matrix
+using the state in ctx
+*************************************************************************/
+{
+	ArcInput input = {NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+
+	input.arcMatrix = arcMatrix;
+	solveInput(ctx, numNodesIn, numArcsIn, sourceIn, sinkIn, &input, lambdaRange, roundNegativeCapacityIn, numBreakpoints, cuts, breakpoints, stats, times);
+}
+
+void hpf_context_solve_arrays(hpf_context *ctx, int numNodesIn, int numArcsIn, int sourceIn, int sinkIn, const int *from, const int *to, const double *constant, const double *multiplier, double lambdaRange[2], int roundNegativeCapacityIn, int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5], double times[3] )
+/*************************************************************************
+hpf_context_solve_arrays - Solves a parametric cut problem given as
+separate arc arrays using the state in ctx
+*************************************************************************/
+{
+	ArcInput input = {NULL, NULL, NULL, NULL, NULL, NULL, NULL};
 
-        double lambdaIntersect = computeIntersect(pdifference_low_high, K12);
+	input.from = from;
+	input.to = to;
+	input.constant = constant;
+	input.multiplier = multiplier;
+	solveInput(ctx, numNodesIn, numArcsIn, sourceIn, sinkIn, &input, lambdaRange, roundNegativeCapacityIn, numBreakpoints, cuts, breakpoints, stats, times);
+}
 
-        // printf("Intersect: %lf\n", lambdaIntersect);
+void hpf_context_solve_arrays64(hpf_context *ctx, int numNodesIn, int numArcsIn, int sourceIn, int sinkIn, const long long *from, const long long *to, const double *constant, const double *multiplier, double lambdaRange[2], int roundNegativeCapacityIn, int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5], double times[3] )
+/*************************************************************************
+hpf_context_solve_arrays64 - hpf_context_solve_arrays with 64 bit node
+numbers
+*************************************************************************/
+{
+	ArcInput input = {NULL, NULL, NULL, NULL, NULL, NULL, NULL};
 
-        // find minimal and maximal source set at lambdaIntersect.
-        // Add/subtract TOL to prevent numerical issues.
-        CutProblem minimalIntersect;
-        initializeContractedProblem(&minimalIntersect, nodeListSuper, numNodesSuper, arcListSuper, numArcsSuper,math_max(lambdaIntersect - TOL, LAMBDA_LOW), lowProblem->optimalSourceSetIndicator, highProblem->optimalSourceSetIndicator);
+	input.from64 = from;
+	input.to64 = to;
+	input.constant = constant;
+	input.multiplier = multiplier;
+	solveInput(ctx, numNodesIn, numArcsIn, sourceIn, sinkIn, &input, lambdaRange, roundNegativeCapacityIn, numBreakpoints, cuts, breakpoints, stats, times);
+}
 
-        solveProblem(&minimalIntersect, 0);
-        destroyProblem(&minimalIntersect, 0);
+void hpf_context_solve_lambdas(hpf_context *ctx, int numNodesIn, int numArcsIn, int sourceIn, int sinkIn, const int *from, const int *to, const double *constant, const double *multiplier, int numLambdas, const double *lambdas, int roundNegativeCapacityIn, int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5], double times[3] )
+/*************************************************************************
+hpf_context_solve_lambdas - Solves a cut problem given as separate arc
+arrays for every lambda of a sorted list
+*************************************************************************/
+{
+	ArcInput input = {NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+	double lambdaRange[2] = {0.0, 0.0};
+	int i;
 
-		CutProblem maximalIntersect;
-        initializeContractedProblem(&maximalIntersect, nodeListSuper, numNodesSuper, arcListSuper, numArcsSuper,math_min(lambdaIntersect + TOL, LAMBDA_HIGH), minimalIntersect.optimalSourceSetIndicator, highProblem->optimalSourceSetIndicator);
+	for (i = 1; i < numLambdas; ++i)
+	{
+		if (lambdas[i] < lambdas[i - 1])
+		{
+			printf("The lambdas should be sorted, but lambda %d is %f and lambda %d is %f.\n", i - 1, lambdas[i - 1], i, lambdas[i]);
+			exit(0);
+		}
+	}
+	if (numLambdas > 0)
+	{
+		lambdaRange[0] = lambdas[0];
+		lambdaRange[1] = lambdas[numLambdas - 1];
+	}
 
-        solveProblem(&maximalIntersect, 0);
-        destroyProblem(&maximalIntersect, 0);
+	input.from = from;
+	input.to = to;
+	input.constant = constant;
+	input.multiplier = multiplier;
 
-        // check if lambdaIntersect is a breakpoint by comparing min and max source set.
-        uint *pdifference_min_max_intersect;
-        differenceSourceSets(&pdifference_min_max_intersect, minimalIntersect.optimalSourceSetIndicator, maximalIntersect.optimalSourceSetIndicator);
-        uint num_nodes_different_min_max = sum_array_uint(pdifference_min_max_intersect, numNodesSuper);
-        free(pdifference_min_max_intersect);
+	ctx->sweepLambdas = lambdas;
+	ctx->numSweepLambdas = (uint) numLambdas;
+	solveInput(ctx, numNodesIn, numArcsIn, sourceIn, sinkIn, &input, lambdaRange, roundNegativeCapacityIn, numBreakpoints, cuts, breakpoints, stats, times);
+	ctx->sweepLambdas = NULL;
+	ctx->numSweepLambdas = 0;
+}
 
-        if (num_nodes_different_min_max > 0 )
-        {
-            // Intersection is a breakpoint
-            addBreakpoint(lambdaIntersect, minimalIntersect.optimalSourceSetIndicator);
-        }
-        else
-        {
-            // Intersection is not a breakpoint and must thus separate two breakpoints. Recurse.
-            // printf("Recursion\n");
+static const char * mapGraphFile(const char *filename, size_t *size)
+/*************************************************************************
+mapGraphFile - Maps a binary graph file in memory, or reads it to memory
+where mmap is not available
+*************************************************************************/
+{
+	char *data;
+#ifndef _WIN32
+	struct stat status;
+	int descriptor = open(filename, O_RDONLY);
+
+	if (descriptor < 0 || fstat(descriptor, &status) != 0)
+	{
+		printf("I/O error while opening graph file %s\n", filename);
+		exit(0);
+	}
 
-            /* recurse for lower subinterval */
-    		parametricCut(lowProblem, &minimalIntersect);
+	*size = (size_t) status.st_size;
+	if (*size < sizeof(hpf_graph_header))
+	{
+		printf("%s is not a graph file\n", filename);
+		exit(0);
+	}
 
-    		/* recurse for higher subinterval */
-    		parametricCut(&maximalIntersect, highProblem);
+	data = (char *) mmap(NULL, *size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	close(descriptor);
+	if (data == MAP_FAILED)
+	{
+		printf("I/O error while reading %s\n", filename);
+		exit(0);
+	}
+#else
+	long length;
+	FILE* f = fopen(filename, "rb");
 
-        }
+	if (f == NULL)
+	{
+		printf("I/O error while opening graph file %s\n", filename);
+		exit(0);
+	}
 
-        /* call destructor function */
-        destroyProblem(&minimalIntersect, 1);
-        destroyProblem(&maximalIntersect, 1);
+	fseek(f, 0, SEEK_END);
+	length = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	*size = (size_t) length;
 
+	if ((data = (char *)malloc(*size + 1)) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+	if (fread(data, 1, *size, f) != *size)
+	{
+		printf("I/O error while reading %s\n", filename);
+		exit(0);
+	}
+	fclose(f);
+#endif
+
+	return data;
+}
+
+static void unmapGraphFile(const char *data, size_t size)
+/*************************************************************************
+unmapGraphFile
+*************************************************************************/
+{
+#ifndef _WIN32
+	munmap((void *) data, size);
+#else
+	free((void *) data);
+#endif
+}
+
+static void checkGraphHeader(const hpf_graph_header *header, size_t size, const char *filename)
+/*************************************************************************
+checkGraphHeader - Checks that the header describes a problem that fits
+in a file of size bytes. The arcs themselves are not checked.
+*************************************************************************/
+{
+	if (size < sizeof(hpf_graph_header) || memcmp(header->magic, HPF_GRAPH_MAGIC, sizeof header->magic) != 0)
+	{
+		printf("%s is not a graph file\n", filename);
+		exit(0);
+	}
+	if (header->version != HPF_GRAPH_VERSION)
+	{
+		printf("Graph file %s has an unsupported version or byte order\n", filename);
+		exit(0);
+	}
+	if (header->numNodes < 2 || header->numArcs < 0
+			|| header->source < 0 || header->source >= header->numNodes
+			|| header->sink < 0 || header->sink >= header->numNodes || header->source == header->sink)
+	{
+		printf("Graph file %s has an invalid header\n", filename);
+		exit(0);
+	}
+	if ((size - sizeof(hpf_graph_header)) / (2 * sizeof(int) + 2 * sizeof(double)) < (size_t) header->numArcs)
+	{
+		printf("Graph file %s is truncated\n", filename);
+		exit(0);
+	}
+}
+
+void hpf_write_graph(const char *filename, int numNodes, int numArcs, int source, int sink, const int *from, const int *to, const double *constant, const double *multiplier, double lambdaRange[2], int roundNegativeCapacity)
+/*************************************************************************
+hpf_write_graph - Writes a problem to a binary graph file
+*************************************************************************/
+{
+	hpf_graph_header header;
+	double zeros[512];
+	int written;
+	int count;
+	int isWritten;
+	FILE* f = fopen(filename, "wb");
+
+	if (f == NULL)
+	{
+		printf("I/O error while opening output file %s\n", filename);
+		exit(0);
+	}
+
+	memset(&header, 0, sizeof header);
+	memcpy(header.magic, HPF_GRAPH_MAGIC, sizeof header.magic);
+	header.version = HPF_GRAPH_VERSION;
+	header.numNodes = numNodes;
+	header.numArcs = numArcs;
+	header.source = source;
+	header.sink = sink;
+	header.roundNegativeCapacity = roundNegativeCapacity;
+	header.lambdaRange[0] = lambdaRange[0];
+	header.lambdaRange[1] = lambdaRange[1];
+
+	isWritten = fwrite(&header, sizeof header, 1, f) == 1
+		&& fwrite(from, sizeof(int), numArcs, f) == (size_t) numArcs
+		&& fwrite(to, sizeof(int), numArcs, f) == (size_t) numArcs
+		&& fwrite(constant, sizeof(double), numArcs, f) == (size_t) numArcs;
+
+	if (multiplier != NULL)
+	{
+		isWritten = isWritten && fwrite(multiplier, sizeof(double), numArcs, f) == (size_t) numArcs;
+	}
+	else
+	{
+		memset(zeros, 0, sizeof zeros);
+		for (written = 0; isWritten && written < numArcs; written += count)
+		{
+			count = (numArcs - written < 512) ? numArcs - written : 512;
+			isWritten = fwrite(zeros, sizeof(double), count, f) == (size_t) count;
+		}
+	}
+
+	if (fclose(f) != 0 || !isWritten)
+	{
+		printf("I/O error while writing %s\n", filename);
+		exit(0);
 	}
-    else
-    {
-        // printf("Stop recursion: Same cuts!\n");
-    }
-free(pdifference_low_high);
 }
 
-void reset_globals()
+void hpf_context_solve_file(hpf_context *ctx, const char *filename, double lambdaRange[2], int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5], double times[3] )
+/*************************************************************************
+hpf_context_solve_file - Solves the problem in a binary graph file using
+the state in ctx. The file stays mapped during the solve, and its arc
+arrays are passed to solveInput as they are.
+*************************************************************************/
 {
-	TOL = 1E-8;
-	numNodes = 0;
-	numArcs = 0;
-	numNodesSuper = 0;
-	numArcsSuper = 0;
-	source = 0;
-	sink = 0;
-	highestStrongLabel = 1;
+	ArcInput input = {NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+	size_t size;
+	const char *data = mapGraphFile(filename, &size);
+	const hpf_graph_header *header = (const hpf_graph_header *) data;
+	double range[2];
 
-	numArcScans = 0;
-	numPushes = 0;
-	numMergers = 0;
-	numRelabels = 0;
-	numGaps = 0;
+	checkGraphHeader(header, size, filename);
 
-	nodesList = NULL;
-	strongRoots = NULL;
-	labelCount = NULL;
-	arcList = NULL;
-	nodeListSuper = NULL;
-	arcListSuper = NULL;
-	lowestPositiveExcessNode = 0;
+	input.from = (const int *) (data + sizeof(hpf_graph_header));
+	input.to = input.from + header->numArcs;
+	input.constant = (const double *) (input.to + header->numArcs);
+	input.multiplier = input.constant + header->numArcs;
 
-	lastBreakpoint = NULL;
-	firstBreakpoint = NULL;
+	range[0] = (lambdaRange != NULL) ? lambdaRange[0] : header->lambdaRange[0];
+	range[1] = (lambdaRange != NULL) ? lambdaRange[1] : header->lambdaRange[1];
 
-	useParametricCut = 1;
-	roundNegativeCapacity = 0;
+	solveInput(ctx, header->numNodes, header->numArcs, header->source, header->sink, &input, range, header->roundNegativeCapacity, numBreakpoints, cuts, breakpoints, stats, times);
 
-	LAMBDA_LOW = 0;
-	LAMBDA_HIGH = 0;
+	unmapGraphFile(data, size);
 }
 
-void hpf_solve(int numNodesIn, int numArcsIn, int sourceIn, int sinkIn, double * arcMatrix, double lambdaRange[2], int roundNegativeCapacityIn, int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5], double times[3] )
+struct hpf_graph
+{
+	int numNodes;
+	int numArcs;
+	int source;
+	int sink;
+	int roundNegativeCapacity;
+	double lambdaRange[2];
+	int *from;
+	int *to;
+	double *constant;
+	double *multiplier;
+	/* final flows of the previous solve at both ends of the lambda range */
+	CutProblem lowFlows;
+	CutProblem highFlows;
+	hpf_context *ctx;
+};
+
+static void createKeptFlows(CutProblem *kept, int numNodes, int numArcs)
 /*************************************************************************
-main - Main function
+createKeptFlows - Allocates room for the interior flows of all arcs and
+the source sets of the contraction they belong to
 *************************************************************************/
 {
-	reset_globals();
+	size_t numWords = ((size_t)numNodes + WORD_BITS - 1) / WORD_BITS + 1;
 
-	double readStart, readEnd, initStart, initEnd, solveStart, solveEnd;
+	kept->solved = 0;
+	kept->numInteriorArcs = 0;
+	if ((kept->lowSourceSet = (ullint *)malloc(numWords * sizeof(ullint))) == NULL ||
+		(kept->highSourceSet = (ullint *)malloc(numWords * sizeof(ullint))) == NULL ||
+		(kept->interiorArcFlow = (double *)malloc((numArcs + 1) * sizeof(double))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+}
 
-	numArcScans = 0;
-	numMergers = 0;
-	numPushes = 0;
-	numRelabels = 0;
-	numGaps = 0;
+hpf_graph * hpf_graph_create(int numNodes, int numArcs, int source, int sink, const int *from, const int *to, const double *constant, const double *multiplier, double lambdaRange[2], int roundNegativeCapacity)
+/*************************************************************************
+hpf_graph_create - Copies a problem into a graph handle with its own
+context
+*************************************************************************/
+{
+	hpf_graph *graph;
+	int i;
 
-	// printf("NumNodes: %d\n", numNodesIn);
-	// printf("NumArcs: %d\n", numArcsIn);
-	// printf("Lambda Range: [%lf, %lf]\n", lambdaRange[0], lambdaRange[1]);
-	// printf("Round if negative: %d\n", roundNegativeCapacity);
-	// printf("Arc matrix:\n");
-	// for (int i = 0; i < numArcsIn; ++i)
-	// {
-	// 	printf("Row %d: [%.2lf, %.2lf, %.2lf, %.2lf]\n", i, arcMatrix[i * 4 + 0 ], arcMatrix[i * 4 + 1 ], arcMatrix[i * 4 + 2 ], arcMatrix[i * 4 + 3 ]);
-	// }
+	if ((graph = (hpf_graph *)malloc(sizeof(hpf_graph))) == NULL ||
+		(graph->from = (int *)malloc((numArcs + 1) * sizeof(int))) == NULL ||
+		(graph->to = (int *)malloc((numArcs + 1) * sizeof(int))) == NULL ||
+		(graph->constant = (double *)malloc((numArcs + 1) * sizeof(double))) == NULL ||
+		(graph->multiplier = (double *)malloc((numArcs + 1) * sizeof(double))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
 
-	readStart = clock();
-	// readInput
-	numNodesSuper = numNodesIn;
-	numArcsSuper = numArcsIn;
-	sourceSuper = (uint) sourceIn;
-	sinkSuper = (uint) sinkIn;
-	LAMBDA_LOW = lambdaRange[0];
-	LAMBDA_HIGH = lambdaRange[1];
-	roundNegativeCapacity = roundNegativeCapacityIn;
-	readGraphSuper( arcMatrix );
-	readEnd = clock();
-
-	initStart = clock();
-	CutProblem lowProblem;
-	CutProblem highProblem;
-	initializeParametricCut(&lowProblem,&highProblem);
-	initEnd = clock();
+	graph->numNodes = numNodes;
+	graph->numArcs = numArcs;
+	graph->source = source;
+	graph->sink = sink;
+	graph->roundNegativeCapacity = roundNegativeCapacity;
+	graph->lambdaRange[0] = lambdaRange[0];
+	graph->lambdaRange[1] = lambdaRange[1];
 
-	solveStart = clock();
-	if (useParametricCut == 1)
+	if (numArcs > 0)
 	{
-        // solve lower bound problem
-        solveProblem(&lowProblem, 0);
-        destroyProblem(&lowProblem, 0);
+		memcpy(graph->from, from, numArcs * sizeof(int));
+		memcpy(graph->to, to, numArcs * sizeof(int));
+		memcpy(graph->constant, constant, numArcs * sizeof(double));
+	}
+	for (i = 0; i < numArcs; ++i)
+	{
+		graph->multiplier[i] = (multiplier != NULL) ? multiplier[i] : 0.0;
+	}
 
-        // solve upper bound problem
-        solveProblem(&highProblem, 0);
-        destroyProblem(&lowProblem, 0);
+	createKeptFlows(&graph->lowFlows, numNodes, numArcs);
+	createKeptFlows(&graph->highFlows, numNodes, numArcs);
+	graph->ctx = hpf_context_create();
 
-        // find breakpoints + recurse
-		parametricCut(&lowProblem, &highProblem);
+	return graph;
+}
 
-        // add upper bound as final breakpoint for last interval.
-        addBreakpoint(highProblem.lambdaValue, highProblem.optimalSourceSetIndicator);
+hpf_context * hpf_graph_context(hpf_graph *graph)
+/*************************************************************************
+hpf_graph_context - The context that solves the graph, for its options
+*************************************************************************/
+{
+	return graph->ctx;
+}
 
-		/* deallocate memory */
-		destroyProblem(&lowProblem, 1);
-		destroyProblem(&highProblem, 1);
+void hpf_graph_set_capacities(hpf_graph *graph, int numChanges, const int *arcs, const double *constant, const double *multiplier)
+/*************************************************************************
+hpf_graph_set_capacities - Replaces the capacities of some arcs. The flows
+of the previous solve are kept, and the next solve starts from them.
+*************************************************************************/
+{
+	int i;
+
+	for (i = 0; i < numChanges; ++i)
+	{
+		if (arcs[i] < 0 || arcs[i] >= graph->numArcs)
+		{
+			printf("Arc %d does not exist, the graph has %d arcs.\n", arcs[i], graph->numArcs);
+			exit(0);
+		}
+
+		if (constant != NULL)
+		{
+			graph->constant[arcs[i]] = constant[i];
+		}
+		if (multiplier != NULL)
+		{
+			graph->multiplier[arcs[i]] = multiplier[i];
+		}
 	}
-	else
+}
+
+void hpf_graph_solve(hpf_graph *graph, double lambdaRange[2], int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5], double times[3] )
+/*************************************************************************
+hpf_graph_solve - Solves the graph with its current capacities. The low
+and high problems start from their final flows of the previous solve, which
+are rounded to empty or saturated arcs as for warm starts, so only the
+nodes around changed arcs carry excesses or deficits.
+*************************************************************************/
+{
+	ArcInput input = {NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+	double range[2];
+
+	input.from = graph->from;
+	input.to = graph->to;
+	input.constant = graph->constant;
+	input.multiplier = graph->multiplier;
+
+	range[0] = (lambdaRange != NULL) ? lambdaRange[0] : graph->lambdaRange[0];
+	range[1] = (lambdaRange != NULL) ? lambdaRange[1] : graph->lambdaRange[1];
+
+	graph->ctx->previousLow = &graph->lowFlows;
+	graph->ctx->previousHigh = &graph->highFlows;
+	solveInput(graph->ctx, graph->numNodes, graph->numArcs, graph->source, graph->sink, &input, range, graph->roundNegativeCapacity, numBreakpoints, cuts, breakpoints, stats, times);
+	graph->ctx->previousLow = NULL;
+	graph->ctx->previousHigh = NULL;
+}
+
+void hpf_graph_destroy(hpf_graph *graph)
+/*************************************************************************
+hpf_graph_destroy - Releases a graph handle and its context
+*************************************************************************/
+{
+	hpf_context_destroy(graph->ctx);
+	free(graph->lowFlows.lowSourceSet);
+	free(graph->lowFlows.highSourceSet);
+	free(graph->lowFlows.interiorArcFlow);
+	free(graph->highFlows.lowSourceSet);
+	free(graph->highFlows.highSourceSet);
+	free(graph->highFlows.interiorArcFlow);
+	free(graph->from);
+	free(graph->to);
+	free(graph->constant);
+	free(graph->multiplier);
+	free(graph);
+}
+
+typedef struct BatchResult
+{
+	int numBreakpoints;
+	int *cuts;
+	double *breakpoints;
+	int stats[5];
+} BatchResult;
+
+typedef struct BatchTask
+{
+#ifndef HPF_NO_THREADS
+	pthread_mutex_t lock;
+#endif
+	int nextGraph;
+	int numGraphs;
+	const int *numNodes;
+	const int *arcOffsets;
+	const int *sources;
+	const int *sinks;
+	const int *from;
+	const int *to;
+	const double *constant;
+	const double *multiplier;
+	const double *lambdaRanges;
+	int roundNegativeCapacity;
+	BatchResult *results;
+} BatchTask;
+
+static int nextBatchGraph(BatchTask *task)
+/*************************************************************************
+nextBatchGraph - Hands out the next graph of a batch, or -1 once all graphs
+have been handed out
+*************************************************************************/
+{
+	int graph;
+
+#ifndef HPF_NO_THREADS
+	pthread_mutex_lock(&task->lock);
+#endif
+	graph = (task->nextGraph < task->numGraphs) ? task->nextGraph++ : -1;
+#ifndef HPF_NO_THREADS
+	pthread_mutex_unlock(&task->lock);
+#endif
+
+	return graph;
+}
+
+static void * solveBatchGraphs(void *arg)
+/*************************************************************************
+solveBatchGraphs - Solves graphs of a batch until there are none left,
+reusing the memory of one context for all of them
+*************************************************************************/
+{
+	BatchTask *task = (BatchTask *)arg;
+	hpf_context *ctx = hpf_context_create();
+	BatchResult *result;
+	double lambdaRange[2];
+	double times[3];
+	int first;
+	int g;
+
+	while ((g = nextBatchGraph(task)) >= 0)
 	{
-		solveProblem(&lowProblem,0);
-		/* add solution as breakpoint */
-		addBreakpoint(lowProblem.lambdaValue, lowProblem.optimalSourceSetIndicator);
-		/* deallocate memory */
-		destroyProblem(&lowProblem, 1);
+		result = &task->results[g];
+		first = task->arcOffsets[g];
+		lambdaRange[0] = task->lambdaRanges[2 * g];
+		lambdaRange[1] = task->lambdaRanges[2 * g + 1];
+
+		hpf_context_solve_arrays(ctx, task->numNodes[g], task->arcOffsets[g + 1] - first, task->sources[g], task->sinks[g],
+			task->from + first, task->to + first, task->constant + first, (task->multiplier != NULL) ? task->multiplier + first : NULL,
+			lambdaRange, task->roundNegativeCapacity, &result->numBreakpoints, &result->cuts, &result->breakpoints, result->stats, times);
 	}
-	solveEnd = clock();
 
-	times[0] = (readEnd - readStart)/CLOCKS_PER_SEC;
-	times[1] = (initEnd - initStart)/CLOCKS_PER_SEC;
-	times[2] = (solveEnd - solveStart)/CLOCKS_PER_SEC;
+	hpf_context_destroy(ctx);
 
-	/* RECOVER FLOW NEEDS TO BE ADAPTED TO DEAL WITH PARAMETRIC ALGORITHM */
-	//	recoverFlow( numNodes );
-	//	flow = checkOptimality (numNodes);
+	return NULL;
+}
 
-	prepareOutput(numBreakpoints, cuts, breakpoints, stats);
+void hpf_solve_batch(int numGraphs, const int *numNodes, const int *arcOffsets, const int *sources, const int *sinks, const int *from, const int *to, const double *constant, const double *multiplier, const double *lambdaRanges, int roundNegativeCapacityIn, int numThreads, long long ** breakpointOffsets, double ** breakpoints, long long ** cutOffsets, int ** cuts, int * stats)
+/*************************************************************************
+hpf_solve_batch - Solves a batch of independent problems. The graphs are
+handed out one at a time to the threads, and the outputs are concatenated
+in the order of the graphs once all of them are solved. The offsets are
+64-bit, since a large batch has more cut entries than an int can count.
+*************************************************************************/
+{
+	BatchTask task;
+	BatchResult *result;
+	size_t numBreakpointsTotal = 0;
+	size_t numCutsTotal = 0;
+	size_t numCuts;
+	int g, i;
+
+	if (numThreads < 1)
+	{
+		printf("The number of threads should be at least 1.\n");
+		exit(0);
+	}
 
-	// printf("Stats: [%d, %d, %d, %d, %d]\n", stats[0],stats[1],stats[2],stats[3],stats[4]);
-	// printf("times: [%lf, %lf, %lf]\n", times[0],times[1],times[2]);
-	// printf("Num breakpoints: %d\n", *numBreakpoints);
-	// printf("breakpoints:\n");
-	// for (int i = 0; i < *numBreakpoints; ++i)
-	// {
-	// 	printf("Breakpoint: %lf\n", (*breakpoints)[i]);
-	// 	for (int j = 0; j < (int)numNodesSuper; j++)
-	// 	{
-	// 		printf("Cut indicator: %d\n", (*cuts)[i * (int) numNodesSuper + j ]);
-	// 	}
-	// }
+	task.nextGraph = 0;
+	task.numGraphs = numGraphs;
+	task.numNodes = numNodes;
+	task.arcOffsets = arcOffsets;
+	task.sources = sources;
+	task.sinks = sinks;
+	task.from = from;
+	task.to = to;
+	task.constant = constant;
+	task.multiplier = multiplier;
+	task.lambdaRanges = lambdaRanges;
+	task.roundNegativeCapacity = roundNegativeCapacityIn;
+
+	if ((task.results = (BatchResult *)malloc((numGraphs + 1) * sizeof(BatchResult))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+
+#ifndef HPF_NO_THREADS
+	pthread_t *threads;
+	int numStarted = 0;
+
+	if (numThreads > numGraphs)
+	{
+		numThreads = (numGraphs > 0) ? numGraphs : 1;
+	}
+	if ((threads = (pthread_t *)malloc(numThreads * sizeof(pthread_t))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+
+	pthread_mutex_init(&task.lock, NULL);
+	for (i = 1; i < numThreads; ++i)
+	{
+		if (pthread_create(&threads[numStarted], NULL, solveBatchGraphs, &task) == 0)
+		{
+			++ numStarted;
+		}
+	}
+	solveBatchGraphs(&task);
+	for (i = 0; i < numStarted; ++i)
+	{
+		pthread_join(threads[i], NULL);
+	}
+	pthread_mutex_destroy(&task.lock);
+	free(threads);
+#else
+	solveBatchGraphs(&task);
+#endif
+
+	/* concatenate the outputs */
+	for (g = 0; g < numGraphs; ++g)
+	{
+		numBreakpointsTotal += (size_t) task.results[g].numBreakpoints;
+		numCutsTotal += (size_t) task.results[g].numBreakpoints * numNodes[g];
+	}
+
+	if ((*breakpointOffsets = (long long *)malloc((numGraphs + 1) * sizeof(long long))) == NULL ||
+		(*cutOffsets = (long long *)malloc((numGraphs + 1) * sizeof(long long))) == NULL ||
+		(*breakpoints = (double *)malloc((numBreakpointsTotal + 1) * sizeof(double))) == NULL ||
+		(*cuts = (int *)malloc((numCutsTotal + 1) * sizeof(int))) == NULL)
+	{
+		printf("Could not allocate memory.\n");
+		exit(0);
+	}
+
+	(*breakpointOffsets)[0] = 0;
+	(*cutOffsets)[0] = 0;
+	for (g = 0; g < numGraphs; ++g)
+	{
+		result = &task.results[g];
+		(*breakpointOffsets)[g + 1] = (*breakpointOffsets)[g] + result->numBreakpoints;
+		numCuts = (size_t) result->numBreakpoints * numNodes[g];
+		(*cutOffsets)[g + 1] = (*cutOffsets)[g] + (long long) numCuts;
+
+		memcpy(*breakpoints + (*breakpointOffsets)[g], result->breakpoints, result->numBreakpoints * sizeof(double));
+		memcpy(*cuts + (*cutOffsets)[g], result->cuts, numCuts * sizeof(int));
+		if (stats != NULL)
+		{
+			for (i = 0; i < 5; ++i)
+			{
+				stats[5 * g + i] = result->stats[i];
+			}
+		}
+
+		free(result->breakpoints);
+		free(result->cuts);
+	}
 
+	free(task.results);
+}
 
-	freeMemoryComplete ();
+void hpf_solve(int numNodesIn, int numArcsIn, int sourceIn, int sinkIn, double * arcMatrix, double lambdaRange[2], int roundNegativeCapacityIn, int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5], double times[3] )
+/*************************************************************************
+hpf_solve - Solves a parametric cut problem in a private context
+*************************************************************************/
+{
+	hpf_context *ctx = hpf_context_create();
 
+	hpf_context_solve(ctx, numNodesIn, numArcsIn, sourceIn, sinkIn, arcMatrix, lambdaRange, roundNegativeCapacityIn, numBreakpoints, cuts, breakpoints, stats, times);
 
+	hpf_context_destroy(ctx);
 }
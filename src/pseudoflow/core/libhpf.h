@@ -1,3 +1,289 @@
+#ifndef LIBHPF_H
+#define LIBHPF_H
+
+/* Opaque solver state. A context may be reused for consecutive solves, but
+   must not be shared between threads that solve at the same time. */
+typedef struct hpf_context hpf_context;
+
+/* Settings of a context, changed with hpf_context_set_option.
+   HPF_OPTION_NUM_THREADS: number of threads used to search the lambda
+   range (default 1). Breakpoints and cuts do not depend on it.
+   HPF_OPTION_WARM_START: if 1, every subproblem starts from the final flow
+   of the problem solved before it instead of from zero flow (default 0).
+   HPF_OPTION_CUT_FORMAT: layout of the cuts output, see hpf_cut_format
+   (default HPF_CUTS_DENSE).
+   HPF_OPTION_REGION_THREADS: number of threads that presolve ranges of
+   consecutive nodes of every large subproblem (default 1). Cuts and
+   breakpoints do not depend on it.
+   HPF_OPTION_GLOBAL_UPDATE: if positive, the labels of the strong nodes are
+   recomputed by a search from the weak nodes whenever a subproblem has
+   done value times its number of nodes and arcs in arc scans and relabels
+   since the last update (default 0, no updates).
+   HPF_OPTION_REDUCE_GRAPH: if 1, the graph is reduced before the search.
+   Nodes that are in the source set or in the sink set for the whole lambda
+   range are fixed there, arcs that no cut can contain are removed, and
+   parallel arcs are merged (default 0). Node numbers and cuts do not
+   change. It is not applied to the solves of a graph handle.
+   HPF_OPTION_EXACT_CAPACITIES: if 1, problems whose constants, multipliers
+   and lambda are integers are solved with integral capacities, and the
+   search finds the cuts next to a breakpoint without a tolerance (default
+   1). If the library is built with HPF_INTEGER_CAPACITIES, capacities and
+   flows are 64-bit integers and every problem has to be solved this way.
+   HPF_OPTION_CUT_VALUES: if 1, a solve also computes the capacity of the
+   minimum cut at every breakpoint, read with hpf_context_get_cut_values
+   (default 0). */
+typedef enum hpf_option
+{
+	HPF_OPTION_NUM_THREADS = 0,
+	HPF_OPTION_WARM_START = 1,
+	HPF_OPTION_CUT_FORMAT = 2,
+	HPF_OPTION_REGION_THREADS = 3,
+	HPF_OPTION_GLOBAL_UPDATE = 4,
+	HPF_OPTION_REDUCE_GRAPH = 5,
+	HPF_OPTION_EXACT_CAPACITIES = 6,
+	HPF_OPTION_CUT_VALUES = 7
+} hpf_option;
+
+/* Layouts of the cuts output.
+   HPF_CUTS_DENSE: numNodes ints per breakpoint, 1 if the node is in the
+   source set and 0 otherwise.
+   HPF_CUTS_PACKED: HPF_CUT_WORDS(numNodes) 32-bit words per breakpoint. Node
+   j is bit j % 32 of word j / 32.
+   HPF_CUTS_INDEX: numNodes ints in total, the index of the first breakpoint
+   whose source set contains the node, or numBreakpoints if there is none.
+   The source sets are nested, so node j is in the source set of breakpoint
+   i if and only if cuts[j] <= i. */
+typedef enum hpf_cut_format
+{
+	HPF_CUTS_DENSE = 0,
+	HPF_CUTS_PACKED = 1,
+	HPF_CUTS_INDEX = 2
+} hpf_cut_format;
+
+#define HPF_CUT_WORDS(numNodes) (((numNodes) + 31) / 32)
+
+/* Counters of the last solve, read with hpf_context_get_stat. The counters
+   have 64 bits. The first five are also returned in the stats argument of
+   hpf_context_solve, where they are capped at INT_MAX.
+   HPF_STAT_NUM_WARM_STARTS: subproblems that were warm started.
+   HPF_STAT_NUM_WARM_START_ARCS: arcs that were saturated by a warm start.
+   HPF_STAT_NUM_BUCKET_SCANS: words of the bitmap of nonempty strong root
+   buckets that were read to select the next strong root.
+   HPF_STAT_NUM_GLOBAL_UPDATES: global updates of the labels.
+   HPF_STAT_NUM_FIXED_NODES: nodes fixed in the source or sink set by
+   HPF_OPTION_REDUCE_GRAPH.
+   HPF_STAT_NUM_REMOVED_ARCS: arcs removed or merged into others by
+   HPF_OPTION_REDUCE_GRAPH.
+   HPF_STAT_NUM_SUBPROBLEMS: cut problems that were solved, at the ends of
+   the range and during the search.
+   HPF_STAT_NUM_LEVELS: levels of the recursion of the search, see
+   hpf_context_get_level. It is 0 if the library is built with
+   HPF_NO_PROFILE.
+   HPF_STAT_NUM_EXACT_SUBPROBLEMS: subproblems that were solved with
+   integral capacities, see HPF_OPTION_EXACT_CAPACITIES. */
+typedef enum hpf_stat
+{
+	HPF_STAT_NUM_ARC_SCANS = 0,
+	HPF_STAT_NUM_MERGERS = 1,
+	HPF_STAT_NUM_PUSHES = 2,
+	HPF_STAT_NUM_RELABELS = 3,
+	HPF_STAT_NUM_GAPS = 4,
+	HPF_STAT_NUM_WARM_STARTS = 5,
+	HPF_STAT_NUM_WARM_START_ARCS = 6,
+	HPF_STAT_NUM_BUCKET_SCANS = 7,
+	HPF_STAT_NUM_GLOBAL_UPDATES = 8,
+	HPF_STAT_NUM_FIXED_NODES = 9,
+	HPF_STAT_NUM_REMOVED_ARCS = 10,
+	HPF_STAT_NUM_SUBPROBLEMS = 11,
+	HPF_STAT_NUM_LEVELS = 12,
+	HPF_STAT_NUM_EXACT_SUBPROBLEMS = 13
+} hpf_stat;
+
+/* Parts of the solve of every subproblem, whose wall clock time is read with
+   hpf_context_get_phase_time.
+   HPF_PHASE_CONTRACT: building the graph of the subproblem from the super
+   graph, with the source and sink sets of its ends contracted.
+   HPF_PHASE_INITIALIZE: createMemoryStructures and the initial pseudoflow.
+   HPF_PHASE_PHASE1: phase 1 of the pseudoflow algorithm, including the
+   presolve of HPF_OPTION_REGION_THREADS.
+   HPF_PHASE_CUT: keeping the flows for a warm start, reading the source
+   set off the labels and evaluating the cut capacity. */
+typedef enum hpf_phase
+{
+	HPF_PHASE_CONTRACT = 0,
+	HPF_PHASE_INITIALIZE = 1,
+	HPF_PHASE_PHASE1 = 2,
+	HPF_PHASE_CUT = 3
+} hpf_phase;
+
+/* Receives the breakpoints of a solve one at a time, in increasing order of
+   lambda, while the solve is running. index counts the breakpoints before
+   this one. sourceSet is the source set of the interval that ends at
+   lambda, laid out as a row of HPF_CUTS_PACKED. The source sets are nested,
+   and addedNodes lists the numAdded nodes that are in sourceSet but not in
+   the source set of the previous breakpoint, in increasing order. Both
+   arrays are only valid during the call. The callback runs on the thread
+   that called the solve. It returns 0 to continue, or any other value to
+   stop the search, in which case the solve returns the breakpoints up to
+   and including this one. */
+typedef int (*hpf_breakpoint_callback)(void *userData, int index, double lambda, const unsigned int *sourceSet, int numAdded, const int *addedNodes);
+
+hpf_context * hpf_context_create(void);
+
+void hpf_context_set_option(hpf_context *ctx, hpf_option option, int value);
+
+/* Passes the breakpoints of subsequent solves of ctx to callback, or stops
+   doing so if callback is NULL. While a callback is set, the source sets are
+   not kept once they have been passed on, and the solve returns NULL cuts
+   and the breakpoints only. */
+void hpf_context_set_callback(hpf_context *ctx, hpf_breakpoint_callback callback, void *userData);
+
+/* Makes the next solves of ctx over a lambda range start from the given
+   source sets at its two ends instead of solving the problems there, so
+   that a range can be split at some lambdas and the parts solved
+   independently, for instance on several machines. lowSourceSet and
+   highSourceSet are rows of HPF_CUTS_PACKED for numNodes nodes, as returned
+   by solves whose range is the single lambda at each end. The arrays are
+   copied, and NULL clears them. A solve then returns the breakpoints
+   between the two ends and the high end with its source set. To combine
+   the parts in increasing order of lambda, concatenate their breakpoints
+   and drop every breakpoint whose source set equals that of the next one,
+   which removes the ends that are not breakpoints of the whole range. */
+void hpf_context_set_range_cuts(hpf_context *ctx, int numNodes, const unsigned int *lowSourceSet, const unsigned int *highSourceSet);
+
+/* Makes the next solves of ctx also find a maximum flow at *lambda, read
+   with hpf_context_get_flows, or stops doing so if lambda is NULL. After the
+   search, the problem at lambda is solved once more on the whole graph,
+   which counts as one more subproblem, and the pseudoflow at the end of
+   phase 1 is turned into a flow by returning the excesses to the source and
+   the deficits to the sink. lambda may lie outside the lambda range. */
+void hpf_context_set_flow_lambda(hpf_context *ctx, const double *lambda);
+
+void hpf_context_solve(hpf_context *ctx, int numNodes, int numArcs, int source, int sink, double * arcMatrix, double lambdaRange[2], int roundNegativeCapacityIn, int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5], double times[3] );
+
+/* Same as hpf_context_solve, with arc i given by from[i], to[i], constant[i]
+   and multiplier[i] instead of a row of arcMatrix. The arrays are read in
+   place during the solve. multiplier may be NULL for a non-parametric
+   problem. */
+void hpf_context_solve_arrays(hpf_context *ctx, int numNodes, int numArcs, int source, int sink, const int *from, const int *to, const double *constant, const double *multiplier, double lambdaRange[2], int roundNegativeCapacityIn, int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5], double times[3] );
+
+void hpf_context_solve_arrays64(hpf_context *ctx, int numNodes, int numArcs, int source, int sink, const long long *from, const long long *to, const double *constant, const double *multiplier, double lambdaRange[2], int roundNegativeCapacityIn, int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5], double times[3] );
+
+/* Same as hpf_context_solve_arrays, but finds the cut for each of the
+   numLambdas values in lambdas, which must be sorted in increasing order,
+   instead of all breakpoints of a range. breakpoints receives the lambdas
+   and cuts one source set per lambda, and numBreakpoints is numLambdas
+   unless a callback stops the search. The problems are solved in order,
+   each from the flows of the one before and with the nodes whose side is
+   already known contracted into the source or the sink. */
+void hpf_context_solve_lambdas(hpf_context *ctx, int numNodes, int numArcs, int source, int sink, const int *from, const int *to, const double *constant, const double *multiplier, int numLambdas, const double *lambdas, int roundNegativeCapacityIn, int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5], double times[3] );
+
+/* Binary graph files hold a problem in the layout of the solver input, so
+   they are mapped in memory and solved without parsing. The file starts
+   with an hpf_graph_header, followed by numArcs ints from, numArcs ints to,
+   numArcs doubles constant and numArcs doubles multiplier, all in the byte
+   order of the machine that wrote the file. */
+#define HPF_GRAPH_MAGIC "HPFGRAPH"
+#define HPF_GRAPH_VERSION 1
+
+typedef struct hpf_graph_header
+{
+	char magic[8];
+	int version;
+	int numNodes;
+	int numArcs;
+	int source;
+	int sink;
+	int roundNegativeCapacity;
+	double lambdaRange[2];
+	int reserved[4];
+} hpf_graph_header;
+
+/* Writes a problem given as in hpf_context_solve_arrays to a binary graph
+   file. multiplier may be NULL. */
+void hpf_write_graph(const char *filename, int numNodes, int numArcs, int source, int sink, const int *from, const int *to, const double *constant, const double *multiplier, double lambdaRange[2], int roundNegativeCapacity);
+
+/* Solves the problem in a binary graph file. The arcs are read in place from
+   the mapped file. lambdaRange overrides the range stored in the file if it
+   is not NULL. */
+void hpf_context_solve_file(hpf_context *ctx, const char *filename, double lambdaRange[2], int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5], double times[3] );
+
+/* Solves numGraphs independent problems in one call with up to numThreads
+   threads, each of which reuses one context for all the graphs it solves.
+   Graph g has numNodes[g] nodes, source sources[g], sink sinks[g] and lambda
+   range lambdaRanges[2 * g], lambdaRanges[2 * g + 1]. Its arcs are arcs
+   arcOffsets[g] .. arcOffsets[g + 1] - 1 of the concatenated arrays from, to,
+   constant and multiplier, as in hpf_context_solve_arrays, with node numbers
+   local to the graph. multiplier may be NULL. The outputs are concatenated:
+   the breakpoints of graph g are breakpoints[breakpointOffsets[g]] ..
+   breakpoints[breakpointOffsets[g + 1] - 1], and its cuts, laid out as in
+   HPF_CUTS_DENSE, start at cuts[cutOffsets[g]]. Both offset arrays have
+   numGraphs + 1 64-bit entries, as the cuts of a large batch can have more
+   entries than an int can count, and, like breakpoints and cuts, are released with
+   libfree. stats may be NULL, or receives 5 counters per graph. */
+void hpf_solve_batch(int numGraphs, const int *numNodes, const int *arcOffsets, const int *sources, const int *sinks, const int *from, const int *to, const double *constant, const double *multiplier, const double *lambdaRanges, int roundNegativeCapacityIn, int numThreads, long long ** breakpointOffsets, double ** breakpoints, long long ** cutOffsets, int ** cuts, int * stats);
+
+/* A problem whose topology stays fixed while its capacities change between
+   solves. The handle keeps a copy of the arcs and the final flows of the
+   problems at both ends of the lambda range, and every solve starts from
+   the flows of the previous one. */
+typedef struct hpf_graph hpf_graph;
+
+/* Copies a problem given as in hpf_context_solve_arrays into a new graph
+   handle. multiplier may be NULL. */
+hpf_graph * hpf_graph_create(int numNodes, int numArcs, int source, int sink, const int *from, const int *to, const double *constant, const double *multiplier, double lambdaRange[2], int roundNegativeCapacity);
+
+/* The context that solves the graph, for hpf_context_set_option and
+   hpf_context_set_callback. It is released with the graph. */
+hpf_context * hpf_graph_context(hpf_graph *graph);
+
+/* Sets the capacity of arc arcs[i] to constant[i] + lambda * multiplier[i]
+   for i < numChanges. constant or multiplier may be NULL to keep the
+   current values. */
+void hpf_graph_set_capacities(hpf_graph *graph, int numChanges, const int *arcs, const double *constant, const double *multiplier);
+
+/* Solves the graph with its current capacities, with outputs as for
+   hpf_context_solve. lambdaRange overrides the range given at creation if
+   it is not NULL. */
+void hpf_graph_solve(hpf_graph *graph, double lambdaRange[2], int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5], double times[3] );
+
+void hpf_graph_destroy(hpf_graph *graph);
+
+unsigned long long hpf_context_get_stat(hpf_context *ctx, hpf_stat stat);
+
+/* Seconds of wall clock time that the last solve of ctx spent in a phase,
+   summed over its subproblems. With several threads the sum can exceed the
+   time of the solve. The phases are not timed, and 0 is returned, if the
+   library is built with HPF_NO_PROFILE. */
+double hpf_context_get_phase_time(hpf_context *ctx, hpf_phase phase);
+
+/* Subproblems of the last solve of ctx at a level of the recursion, for
+   0 <= level < hpf_context_get_stat(ctx, HPF_STAT_NUM_LEVELS). Level 0 holds
+   the problems at the ends of the lambda range, and level k > 0 the
+   problems solved at the intersections found k calls deep in the search.
+   numNodes and numArcs are summed over the numProblems subproblems, after
+   their source and sink sets have been contracted. */
+void hpf_context_get_level(hpf_context *ctx, int level, unsigned long long *numProblems, unsigned long long *numNodes, unsigned long long *numArcs);
+
+/* Capacity of the minimum cut at every breakpoint of the last solve of ctx,
+   which is the capacity of the source set of the breakpoint at its lambda,
+   if HPF_OPTION_CUT_VALUES was set, and NULL otherwise. The array has
+   numBreakpoints entries, belongs to ctx and is valid until its next solve.
+   The values are summed over all arcs of the input, also if the graph is
+   reduced. */
+const double * hpf_context_get_cut_values(hpf_context *ctx);
+
+/* Flow on every arc of the input, in the order of the input, of a maximum
+   flow at the lambda of hpf_context_set_flow_lambda, if it was set for the
+   last solve of ctx, and NULL otherwise. Arcs into the source, out of the
+   sink and self loops carry no flow. The array belongs to ctx and is valid
+   until its next solve. */
+const double * hpf_context_get_flows(hpf_context *ctx);
+
+void hpf_context_destroy(hpf_context *ctx);
+
 void hpf_solve(int numNodes, int numArcs, int source, int sink, double * arcMatrix, double lambdaRange[2], int roundNegativeCapacityIn, int * numBreakpoints, int ** cuts, double ** breakpoints, int stats[5], double times[3] );
 
 void libfree(void * p);
+
+#endif
@@ -1,4 +1,4 @@
-function [cuts, lambdas] = hpf( arcmatrix, num_nodes, source_node, sink_node, lambda_range, rounding );
+function [cuts, lambdas, stats, times] = hpf( arcmatrix, num_nodes, source_node, sink_node, lambda_range, rounding, varargin );
 %   Hochbaum's Pseudo-flow (HPF) Algorithm Matlab implementation
 %   %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %   The HPF algorithm for finding Minimum-cut in a graph is described in:
@@ -19,6 +19,7 @@ function [cuts, lambdas] = hpf( arcmatrix, num_nodes, source_node, sink_node, la
 %
 %   Usage: Within Matlab environment:
 %   [cuts, lambdas, stats, times]  = hpf(arcmatrix, num_nodes, source, sink lambda_range, rounding);
+%   [cuts, lambdas, stats, times]  = hpf(arcmatrix, num_nodes, source, sink lambda_range, rounding, cut_format, threads);
 %
 %   INPUTS
 %
@@ -29,11 +30,18 @@ function [cuts, lambdas] = hpf( arcmatrix, num_nodes, source_node, sink_node, la
 %   sink_node   - The numeric label of the sink node
 %   lambda_range - [lower bound, upper bound] for lambda values.
 %   rounding - 1 if negative arc capacities should be rounded to zero, and 0 otherwise.
+%   cut_format - (optional) 'logical' (default), 'int32' or 'double' for the
+%               class of the cuts matrix, or 'index' for an n x 1 int32 vector
+%               where C(i) is the first lambda interval whose source set
+%               contains node i, and k + 1 if there is none.
+%   threads - (optional) Number of threads that solve subproblems, 1 by default.
 %
 %
 %   OUTPUTS
 %
 %   cuts - n x k matrix where A(i,j) is 1 if node i is in the source cet for lambda interval j.
 %   lambdas - 1 x k matrix where L(j) is the upper bound of the j-th lambda interval.
+%   stats - [number of arc scans; mergers; pushes; relabels; gap relabels]
+%   times - [read time; initialization time; solve time] in seconds.
 
-[cuts, lambdas, stats, time] = hpfMatlab( arcmatrix, num_nodes, source_node, sink_node, lambda_range, rounding );
+[cuts, lambdas, stats, times] = hpfMatlab( arcmatrix, num_nodes, source_node, sink_node, lambda_range, rounding, varargin{:} );
@@ -0,0 +1,273 @@
+/*************************************************************************
+ * CPython extension for the HPF parametric minimum cut solver          *
+ * ***********************************************************************
+ * Gives pseudoflow.hpf a direct entry into the solver core, as an      *
+ * alternative to the ctypes bindings of libhpf. The arcs of a graph    *
+ * are converted to C arrays once, the solve runs without the global    *
+ * interpreter lock, so threads of one process solve in parallel, and   *
+ * the cuts dictionary is built here instead of by indexing a ctypes    *
+ * pointer from Python.                                                 *
+ *                                                                       *
+ * The solver is asked for HPF_CUTS_INDEX, one breakpoint index per     *
+ * node, from which the indicator lists are expanded. The source sets   *
+ * are nested, so node j is in the source set of breakpoint i if and    *
+ * only if cuts[j] <= i.                                                *
+ *************************************************************************/
+
+#define PY_SSIZE_T_CLEAN
+#include "Python.h"
+#include "../core/libhpf.h"
+
+static PyObject * buildCuts(PyObject *nodeNames, int numNodes, int numBreakpoints, const int *cuts, int compactCuts)
+/*************************************************************************
+buildCuts - Dictionary from node name to its breakpoint index, or to its
+list of source set indicators
+*************************************************************************/
+{
+	PyObject *dict, *value, *zero, *one;
+	int i, j;
+
+	if ((dict = PyDict_New()) == NULL)
+	{
+		return NULL;
+	}
+
+	zero = PyLong_FromLong(0);
+	one = PyLong_FromLong(1);
+
+	for (i = 0; i < numNodes; ++i)
+	{
+		if (compactCuts)
+		{
+			value = PyLong_FromLong(cuts[i]);
+		}
+		else if ((value = PyList_New(numBreakpoints)) != NULL)
+		{
+			for (j = 0; j < numBreakpoints; ++j)
+			{
+				PyObject *indicator = (cuts[i] <= j) ? one : zero;
+				Py_INCREF(indicator);
+				PyList_SET_ITEM(value, j, indicator);
+			}
+		}
+
+		if (value == NULL || PyDict_SetItem(dict, PySequence_Fast_GET_ITEM(nodeNames, i), value) < 0)
+		{
+			Py_XDECREF(value);
+			Py_DECREF(dict);
+			dict = NULL;
+			break;
+		}
+		Py_DECREF(value);
+	}
+
+	Py_DECREF(zero);
+	Py_DECREF(one);
+
+	return dict;
+}
+
+static double * readDoubles(PyObject *sequence, Py_ssize_t *length)
+/*************************************************************************
+readDoubles - Copies a sequence of numbers to a new C array
+*************************************************************************/
+{
+	PyObject *fast;
+	double *values;
+	Py_ssize_t i;
+
+	if ((fast = PySequence_Fast(sequence, "expected a sequence of numbers")) == NULL)
+	{
+		return NULL;
+	}
+
+	*length = PySequence_Fast_GET_SIZE(fast);
+	if ((values = (double *)PyMem_Malloc((*length + 1) * sizeof(double))) == NULL)
+	{
+		Py_DECREF(fast);
+		PyErr_NoMemory();
+		return NULL;
+	}
+
+	for (i = 0; i < *length; ++i)
+	{
+		values[i] = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(fast, i));
+	}
+	Py_DECREF(fast);
+
+	if (PyErr_Occurred())
+	{
+		PyMem_Free(values);
+		return NULL;
+	}
+
+	return values;
+}
+
+static PyObject * solve(PyObject *self, PyObject *args, PyObject *kwargs)
+/*************************************************************************
+solve - solve(nodeNames, source, sink, arcMatrix, lambdaRange,
+roundNegativeCapacity, compactCuts, lambdas=None) -> (breakpoints, cuts,
+stats, times). arcMatrix holds [from, to, constant, multiplier] for every
+arc in one flat sequence, with the node indices of nodeNames. If lambdas is
+a sorted sequence, the cuts are found for these lambdas instead of for the
+breakpoints of lambdaRange.
+*************************************************************************/
+{
+	static char *keywords[] = {"nodeNames", "source", "sink", "arcMatrix", "lambdaRange", "roundNegativeCapacity", "compactCuts", "lambdas", NULL};
+	PyObject *nodeNamesIn, *arcMatrixIn, *lambdasIn = Py_None;
+	PyObject *nodeNames = NULL, *breakpointList = NULL, *cutDict = NULL, *result = NULL;
+	int source, sink, roundNegativeCapacity, compactCuts;
+	double lambdaRange[2];
+	double *arcMatrix = NULL, *lambdas = NULL;
+	double *constant = NULL, *multiplier = NULL;
+	int *from = NULL, *to = NULL;
+	Py_ssize_t numValues, numLambdas = 0, i;
+	int numNodes, numArcs;
+	int numBreakpoints = 0;
+	int *cuts = NULL;
+	double *breakpoints = NULL;
+	int stats[5];
+	double times[3];
+	hpf_context *ctx;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OiiO(dd)pp|O", keywords, &nodeNamesIn, &source, &sink, &arcMatrixIn, &lambdaRange[0], &lambdaRange[1], &roundNegativeCapacity, &compactCuts, &lambdasIn))
+	{
+		return NULL;
+	}
+
+	if ((nodeNames = PySequence_Fast(nodeNamesIn, "nodeNames should be a sequence")) == NULL)
+	{
+		return NULL;
+	}
+	numNodes = (int) PySequence_Fast_GET_SIZE(nodeNames);
+
+	if ((arcMatrix = readDoubles(arcMatrixIn, &numValues)) == NULL)
+	{
+		goto done;
+	}
+	if (numValues % 4 != 0)
+	{
+		PyErr_SetString(PyExc_ValueError, "arcMatrix should have four values per arc");
+		goto done;
+	}
+	numArcs = (int) (numValues / 4);
+
+	if (source < 0 || source >= numNodes || sink < 0 || sink >= numNodes)
+	{
+		PyErr_SetString(PyExc_ValueError, "source and sink should be indices of nodeNames");
+		goto done;
+	}
+	for (i = 0; i < numArcs; ++i)
+	{
+		if (arcMatrix[i * 4] < 0 || arcMatrix[i * 4] >= numNodes || arcMatrix[i * 4 + 1] < 0 || arcMatrix[i * 4 + 1] >= numNodes)
+		{
+			PyErr_SetString(PyExc_ValueError, "arcMatrix should only have indices of nodeNames as nodes");
+			goto done;
+		}
+	}
+
+	if (lambdasIn != Py_None)
+	{
+		if ((lambdas = readDoubles(lambdasIn, &numLambdas)) == NULL)
+		{
+			goto done;
+		}
+		for (i = 1; i < numLambdas; ++i)
+		{
+			if (lambdas[i] < lambdas[i - 1])
+			{
+				PyErr_SetString(PyExc_ValueError, "lambdas should be sorted in increasing order.");
+				goto done;
+			}
+		}
+
+		/* hpf_context_solve_lambdas takes separate arrays */
+		from = (int *)PyMem_Malloc((numArcs + 1) * sizeof(int));
+		to = (int *)PyMem_Malloc((numArcs + 1) * sizeof(int));
+		constant = (double *)PyMem_Malloc((numArcs + 1) * sizeof(double));
+		multiplier = (double *)PyMem_Malloc((numArcs + 1) * sizeof(double));
+		if (from == NULL || to == NULL || constant == NULL || multiplier == NULL)
+		{
+			PyErr_NoMemory();
+			goto done;
+		}
+		for (i = 0; i < numArcs; ++i)
+		{
+			from[i] = (int) arcMatrix[i * 4];
+			to[i] = (int) arcMatrix[i * 4 + 1];
+			constant[i] = arcMatrix[i * 4 + 2];
+			multiplier[i] = arcMatrix[i * 4 + 3];
+		}
+	}
+
+	Py_BEGIN_ALLOW_THREADS
+	ctx = hpf_context_create();
+	hpf_context_set_option(ctx, HPF_OPTION_CUT_FORMAT, HPF_CUTS_INDEX);
+	if (lambdas != NULL)
+	{
+		hpf_context_solve_lambdas(ctx, numNodes, numArcs, source, sink, from, to, constant, multiplier, (int) numLambdas, lambdas, roundNegativeCapacity, &numBreakpoints, &cuts, &breakpoints, stats, times);
+	}
+	else
+	{
+		hpf_context_solve(ctx, numNodes, numArcs, source, sink, arcMatrix, lambdaRange, roundNegativeCapacity, &numBreakpoints, &cuts, &breakpoints, stats, times);
+	}
+	hpf_context_destroy(ctx);
+	Py_END_ALLOW_THREADS
+
+	if ((breakpointList = PyList_New(numBreakpoints)) == NULL)
+	{
+		goto done;
+	}
+	for (i = 0; i < numBreakpoints; ++i)
+	{
+		PyObject *value = PyFloat_FromDouble(breakpoints[i]);
+		if (value == NULL)
+		{
+			goto done;
+		}
+		PyList_SET_ITEM(breakpointList, i, value);
+	}
+
+	if ((cutDict = buildCuts(nodeNames, numNodes, numBreakpoints, cuts, compactCuts)) == NULL)
+	{
+		goto done;
+	}
+
+	result = Py_BuildValue("(OO(iiiii)(ddd))", breakpointList, cutDict, stats[0], stats[1], stats[2], stats[3], stats[4], times[0], times[1], times[2]);
+
+done:
+	Py_XDECREF(breakpointList);
+	Py_XDECREF(cutDict);
+	Py_DECREF(nodeNames);
+	PyMem_Free(arcMatrix);
+	PyMem_Free(lambdas);
+	PyMem_Free(from);
+	PyMem_Free(to);
+	PyMem_Free(constant);
+	PyMem_Free(multiplier);
+	libfree(cuts);
+	libfree(breakpoints);
+
+	return result;
+}
+
+static PyMethodDef methods[] =
+{
+	{"solve", (PyCFunction)(void (*)(void))solve, METH_VARARGS | METH_KEYWORDS, "Solves the parametric minimum cut problem of an arc matrix."},
+	{NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef module =
+{
+	PyModuleDef_HEAD_INIT,
+	"_hpf",
+	"Native entry into the HPF parametric minimum cut solver.",
+	-1,
+	methods
+};
+
+PyMODINIT_FUNC PyInit__hpf(void)
+{
+	return PyModule_Create(&module);
+}
@@ -1,11 +1,25 @@
-from ctypes import c_int, c_double, cast, byref, POINTER, cdll
+from ctypes import c_int, c_longlong, c_double, c_void_p, cast, byref, POINTER, cdll
 import os
+import weakref
 
 from pseudoflow.python.graph_wrapper import NetworkxGraphWrapper, IgraphGraphWrapper
 
 PATH = os.path.dirname(__file__)
 libhpf = cdll.LoadLibrary(os.path.join(PATH, os.pardir, "libhpf.so"))
 
+# the native extension is used by hpf if it has been built
+try:
+    from pseudoflow import _hpf
+except ImportError:
+    _hpf = None
+
+# hpf_option and hpf_cut_format in libhpf.h
+HPF_OPTION_CUT_FORMAT = 2
+HPF_OPTION_EXACT_CAPACITIES = 6
+HPF_OPTION_CUT_VALUES = 7
+HPF_CUTS_DENSE = 0
+HPF_CUTS_INDEX = 2
+
 
 def _c_arr(c_type, size, init):
     x = c_type * size
@@ -69,6 +83,24 @@ def _create_c_input(
     }
 
 
+def _add_c_lambdas(c_input, arcMatrix, lambdas):
+    """Passes the arcs as separate arrays, as hpf_context_solve_lambdas
+    takes them, and sets the sorted lambdas."""
+    nArcs = len(arcMatrix) // 4
+    lambdas = [float(x) for x in lambdas]
+    if any(lambdas[i] > lambdas[i + 1] for i in range(len(lambdas) - 1)):
+        raise ValueError("lambdas should be sorted in increasing order.")
+
+    del c_input["arcMatrix"]
+    c_input["numArcs"] = c_int(nArcs)
+    c_input["from"] = _c_arr(c_int, nArcs, [int(x) for x in arcMatrix[0::4]])
+    c_input["to"] = _c_arr(c_int, nArcs, [int(x) for x in arcMatrix[1::4]])
+    c_input["const"] = _c_arr(c_double, nArcs, arcMatrix[2::4])
+    c_input["mult"] = _c_arr(c_double, nArcs, arcMatrix[3::4])
+    c_input["numLambdas"] = c_int(len(lambdas))
+    c_input["lambdas"] = _c_arr(c_double, len(lambdas), lambdas)
+
+
 def _create_c_output():
     c_numBreakpoints = c_int(0)
     c_cuts = POINTER(c_int)()
@@ -85,30 +117,118 @@ def _create_c_output():
     }
 
 
-def _solve(c_input, c_output):
-    hpf_solve = libhpf.hpf_solve
-    hpf_solve.argtypes = [
+def _prototype(name, argtypes, restype=None):
+    function = getattr(libhpf, name)
+    function.argtypes = argtypes
+    function.restype = restype
+    return function
+
+
+# prototypes of the libhpf functions, set once
+_outputTypes = [
+    c_double * 2,
+    c_int,
+    POINTER(c_int),
+    POINTER(POINTER(c_int)),
+    POINTER(POINTER(c_double)),
+    c_int * 5,
+    c_double * 3,
+]
+_hpf_context_create = _prototype("hpf_context_create", [], c_void_p)
+_hpf_context_set_option = _prototype("hpf_context_set_option", [c_void_p, c_int, c_int])
+_hpf_context_destroy = _prototype("hpf_context_destroy", [c_void_p])
+_hpf_context_set_flow_lambda = _prototype("hpf_context_set_flow_lambda", [c_void_p, POINTER(c_double)])
+_hpf_context_get_cut_values = _prototype("hpf_context_get_cut_values", [c_void_p], POINTER(c_double))
+_hpf_context_get_flows = _prototype("hpf_context_get_flows", [c_void_p], POINTER(c_double))
+_hpf_context_solve = _prototype(
+    "hpf_context_solve", [c_void_p, c_int, c_int, c_int, c_int, POINTER(c_double)] + _outputTypes
+)
+_hpf_context_solve_arrays = {
+    nodeType: _prototype(
+        name,
+        [
+            c_void_p,
+            c_int,
+            c_int,
+            c_int,
+            c_int,
+            POINTER(nodeType),
+            POINTER(nodeType),
+            POINTER(c_double),
+            POINTER(c_double),
+        ]
+        + _outputTypes,
+    )
+    for nodeType, name in ((c_int, "hpf_context_solve_arrays"), (c_longlong, "hpf_context_solve_arrays64"))
+}
+_hpf_context_solve_lambdas = _prototype(
+    "hpf_context_solve_lambdas",
+    [
+        c_void_p,
+        c_int,
         c_int,
         c_int,
         c_int,
+        POINTER(c_int),
+        POINTER(c_int),
+        POINTER(c_double),
+        POINTER(c_double),
         c_int,
         POINTER(c_double),
-        c_double * 2,
+    ]
+    + _outputTypes[1:],
+)
+_hpf_solve_batch = _prototype(
+    "hpf_solve_batch",
+    [
         c_int,
         POINTER(c_int),
-        POINTER(POINTER(c_int)),
+        POINTER(c_int),
+        POINTER(c_int),
+        POINTER(c_int),
+        POINTER(c_int),
+        POINTER(c_int),
+        POINTER(c_double),
+        POINTER(c_double),
+        POINTER(c_double),
+        c_int,
+        c_int,
+        POINTER(POINTER(c_longlong)),
         POINTER(POINTER(c_double)),
-        c_int * 5,
-        c_double * 3,
-    ]
+        POINTER(POINTER(c_longlong)),
+        POINTER(POINTER(c_int)),
+        POINTER(c_int),
+    ],
+)
+
+
+def _solve(c_input, c_output, cutFormat=HPF_CUTS_DENSE):
+    """Solves through a context. The arcs are either given by
+    c_input["arcMatrix"], a ctypes array of numArcs * 4 doubles, or by the
+    pointers c_input["from"], ["to"], ["const"] and ["mult"] to separate
+    arrays, where c_input["nodeType"] is c_int or c_longlong. If c_input has
+    "lambdas", a ctypes array of c_input["numLambdas"] sorted doubles, the
+    cuts for these lambdas are found instead, which requires c_int arrays."""
+    if "lambdas" in c_input:
+        hpf_context_solve = _hpf_context_solve_lambdas
+        arcs = (c_input["from"], c_input["to"], c_input["const"], c_input["mult"], c_input["numLambdas"])
+    elif "arcMatrix" in c_input:
+        hpf_context_solve = _hpf_context_solve
+        arcs = (cast(c_input["arcMatrix"], POINTER(c_double)),)
+    else:
+        hpf_context_solve = _hpf_context_solve_arrays[c_input["nodeType"]]
+        arcs = (c_input["from"], c_input["to"], c_input["const"], c_input["mult"])
 
-    hpf_solve(
+    ctx = _hpf_context_create()
+    _hpf_context_set_option(ctx, HPF_OPTION_CUT_FORMAT, cutFormat)
+    hpf_context_solve(
+        ctx,
         c_input["numNodes"],
         c_input["numArcs"],
         c_input["source"],
         c_input["sink"],
-        cast(byref(c_input["arcMatrix"]), POINTER(c_double)),
-        c_input["lambdaRange"],
+        *arcs,
+        c_input["lambdas"] if "lambdas" in c_input else c_input["lambdaRange"],
         c_input["roundNegativeCapacity"],
         byref(c_output["numBreakpoints"]),
         byref(c_output["cuts"]),
@@ -116,6 +236,7 @@ def _solve(c_input, c_output):
         c_output["stats"],
         c_output["times"],
     )
+    _hpf_context_destroy(ctx)
 
 
 def _cleanup(c_output):
@@ -141,28 +262,46 @@ def _check_multipliers_source_adjacent_positive(G, source, mult_cap):
             )
 
 
-def _read_output(c_output, nodeNames):
+def _info(stats, times):
+    return {
+        "numArcScans": stats[0],
+        "numMergers": stats[1],
+        "numPushes": stats[2],
+        "numRelabels": stats[3],
+        "numGap": stats[4],
+        "readDataTime": times[0],
+        "intializationTime": times[1],
+        "solveTime": times[2],
+    }
+
+
+def _read_info(c_output):
+    return _info(c_output["stats"], c_output["times"])
+
+
+def _read_output(c_output, nodeNames, compactCuts=False):
     numBreakpoints = c_output["numBreakpoints"].value
     breakpoints = [c_output["breakpoints"][i] for i in range(numBreakpoints)]
 
     cuts = {}
-    for i, node in enumerate(nodeNames):
-        cuts[node] = [
-            c_output["cuts"][len(nodeNames) * j + i] for j in range(numBreakpoints)
-        ]
+    if compactCuts:
+        for i, node in enumerate(nodeNames):
+            cuts[node] = c_output["cuts"][i]
+    else:
+        for i, node in enumerate(nodeNames):
+            cuts[node] = [
+                c_output["cuts"][len(nodeNames) * j + i] for j in range(numBreakpoints)
+            ]
 
-    info = {
-        "numArcScans": c_output["stats"][0],
-        "numMergers": c_output["stats"][1],
-        "numPushes": c_output["stats"][2],
-        "numRelabels": c_output["stats"][3],
-        "numGap": c_output["stats"][4],
-        "readDataTime": c_output["times"][0],
-        "intializationTime": c_output["times"][1],
-        "solveTime": c_output["times"][2],
-    }
+    return breakpoints, cuts, _read_info(c_output)
 
-    return breakpoints, cuts, info
+
+def _wrap_c_array(np, pointer, shape):
+    """Returns a NumPy array on a buffer allocated by libhpf, which is
+    released with libfree once the array and all its views are gone."""
+    array = np.ctypeslib.as_array(pointer, shape=shape)
+    weakref.finalize(array, libhpf.libfree, pointer)
+    return array
 
 
 def hpf(
@@ -173,7 +312,22 @@ def hpf(
     mult_cap=None,
     lambdaRange=None,
     roundNegativeCapacity=False,
+    compactCuts=False,
+    lambdas=None,
 ):
+    """Solves the parametric minimum cut problem on G.
+
+    If lambdas is a sorted list of lambda values, the minimum cut is found
+    for each of them instead of for all breakpoints of lambdaRange, and
+    breakpoints is lambdas. The cuts are solved in order, each starting from
+    the one before, which is faster than a call per lambda.
+
+    If compactCuts is True, cuts maps every node to the index of the first
+    breakpoint whose source set contains it, or len(breakpoints) if there is
+    none, instead of to a list of indicators. The source sets are nested, so
+    both describe the same cuts, but the compact form uses one integer per
+    node.
+    """
     if "networkx" in G.__module__:
         G = NetworkxGraphWrapper(G)
     elif "igraph" in G.__module__:
@@ -195,14 +349,35 @@ def hpf(
         G, const_cap, mult_cap, source, sink
     )
 
+    if lambdas is not None:
+        lambdaRange = [0.0, 0.0]
+
+    if _hpf is not None:
+        # the solve runs without the GIL, and the cuts are built in C
+        breakpoints, cuts, stats, times = _hpf.solve(
+            nodeNames,
+            nodeDict[source],
+            nodeDict[sink],
+            arcMatrix,
+            lambdaRange,
+            bool(roundNegativeCapacity),
+            bool(compactCuts),
+            lambdas,
+        )
+        if not parametric:
+            breakpoints = [None]
+        return breakpoints, cuts, _info(stats, times)
+
     c_input = _create_c_input(
         nodeDict, source, sink, arcMatrix, lambdaRange, roundNegativeCapacity
     )
+    if lambdas is not None:
+        _add_c_lambdas(c_input, arcMatrix, lambdas)
     c_output = _create_c_output()
 
-    _solve(c_input, c_output)
+    _solve(c_input, c_output, HPF_CUTS_INDEX if compactCuts else HPF_CUTS_DENSE)
 
-    breakpoints, cuts, info = _read_output(c_output, nodeNames)
+    breakpoints, cuts, info = _read_output(c_output, nodeNames, compactCuts)
 
     _cleanup(c_output)
 
@@ -210,3 +385,177 @@ def hpf(
         breakpoints = [None]
 
     return breakpoints, cuts, info
+
+
+def hpf_arrays(
+    from_nodes,
+    to_nodes,
+    const_cap,
+    mult_cap,
+    source,
+    sink,
+    num_nodes=None,
+    lambdaRange=None,
+    roundNegativeCapacity=False,
+    compactCuts=False,
+):
+    """Solves the parametric minimum cut problem on a graph given as arrays.
+
+    Arc i runs from from_nodes[i] to to_nodes[i] and has capacity
+    const_cap[i] + lambda * mult_cap[i]. Nodes are numbered 0 .. num_nodes - 1,
+    num_nodes defaults to the largest node number plus one. mult_cap may be
+    None for a non-parametric problem.
+
+    The arrays are passed to the solver without copying if the node numbers
+    are contiguous int32 or int64 arrays and the capacities contiguous float64
+    arrays. Returns NumPy arrays on the buffers allocated by the solver: the
+    breakpoints, and the cuts as a breakpoints x num_nodes matrix of source
+    set indicators, or with compactCuts=True as one breakpoint index per node
+    (see hpf). The info dictionary is the same as for hpf.
+    """
+    import numpy as np
+
+    from_nodes = np.asarray(from_nodes)
+    to_nodes = np.asarray(to_nodes)
+    if from_nodes.dtype == np.int32 and to_nodes.dtype == np.int32:
+        nodeType = c_int
+    else:
+        nodeType = c_longlong
+    from_nodes = np.ascontiguousarray(from_nodes, dtype=np.dtype(nodeType))
+    to_nodes = np.ascontiguousarray(to_nodes, dtype=np.dtype(nodeType))
+    const_cap = np.ascontiguousarray(const_cap, dtype=np.float64)
+    numArcs = len(const_cap)
+
+    if len(from_nodes) != numArcs or len(to_nodes) != numArcs:
+        raise ValueError("from_nodes, to_nodes and const_cap should have the same length.")
+
+    if mult_cap is None:
+        lambdaRange = [0.0, 0.0]
+    else:
+        mult_cap = np.ascontiguousarray(mult_cap, dtype=np.float64)
+        if len(mult_cap) != numArcs:
+            raise ValueError("mult_cap should have the same length as const_cap.")
+        if np.any(mult_cap[(to_nodes == sink) & (from_nodes != source)] > 0):
+            raise ValueError(
+                "Sink adjacent arcs should have non-positive multipliers. Please reverse graph."
+            )
+        if np.any(mult_cap[(from_nodes == source) & (to_nodes != sink)] < 0):
+            raise ValueError(
+                "Source adjacent arcs should have non-negative multipliers. Please reverse graph."
+            )
+
+    if num_nodes is None:
+        num_nodes = int(max(from_nodes.max(initial=0), to_nodes.max(initial=0), source, sink)) + 1
+
+    c_input = {
+        "numNodes": c_int(num_nodes),
+        "numArcs": c_int(numArcs),
+        "source": c_int(source),
+        "sink": c_int(sink),
+        "nodeType": nodeType,
+        "from": from_nodes.ctypes.data_as(POINTER(nodeType)),
+        "to": to_nodes.ctypes.data_as(POINTER(nodeType)),
+        "const": const_cap.ctypes.data_as(POINTER(c_double)),
+        "mult": None if mult_cap is None else mult_cap.ctypes.data_as(POINTER(c_double)),
+        "lambdaRange": _c_arr(c_double, 2, lambdaRange),
+        "roundNegativeCapacity": c_int(1 if roundNegativeCapacity else 0),
+    }
+    c_output = _create_c_output()
+
+    _solve(c_input, c_output, HPF_CUTS_INDEX if compactCuts else HPF_CUTS_DENSE)
+
+    numBreakpoints = c_output["numBreakpoints"].value
+    breakpoints = _wrap_c_array(np, c_output["breakpoints"], (numBreakpoints,))
+    if compactCuts:
+        cuts = _wrap_c_array(np, c_output["cuts"], (num_nodes,))
+    else:
+        cuts = _wrap_c_array(np, c_output["cuts"], (numBreakpoints, num_nodes))
+
+    return breakpoints, cuts, _read_info(c_output)
+
+
+def hpf_batch(
+    num_nodes,
+    arc_offsets,
+    sources,
+    sinks,
+    from_nodes,
+    to_nodes,
+    const_cap,
+    mult_cap,
+    lambdaRanges,
+    roundNegativeCapacity=False,
+    numThreads=1,
+):
+    """Solves many independent parametric minimum cut problems in one call.
+
+    Graph g has num_nodes[g] nodes, source sources[g] and sink sinks[g], and
+    its arcs are arcs arc_offsets[g] .. arc_offsets[g + 1] - 1 of the
+    concatenated arrays from_nodes, to_nodes, const_cap and mult_cap, with
+    node numbers local to the graph. lambdaRanges has one (lower, upper) row
+    per graph. mult_cap may be None. The graphs are solved by up to
+    numThreads threads.
+
+    Returns the concatenated breakpoints and cuts with their offsets:
+    graph g has breakpoints[breakpoint_offsets[g]:breakpoint_offsets[g + 1]]
+    and its cuts, a matrix of source set indicators as in hpf_arrays, are
+    cuts[cut_offsets[g]:cut_offsets[g + 1]]. Both offset arrays are int64.
+    stats has the five counters of the info dictionary of hpf for every
+    graph.
+    """
+    import numpy as np
+
+    num_nodes = np.ascontiguousarray(num_nodes, dtype=np.intc)
+    numGraphs = len(num_nodes)
+    arc_offsets = np.ascontiguousarray(arc_offsets, dtype=np.intc)
+    sources = np.ascontiguousarray(sources, dtype=np.intc)
+    sinks = np.ascontiguousarray(sinks, dtype=np.intc)
+    from_nodes = np.ascontiguousarray(from_nodes, dtype=np.intc)
+    to_nodes = np.ascontiguousarray(to_nodes, dtype=np.intc)
+    const_cap = np.ascontiguousarray(const_cap, dtype=np.float64)
+    lambdaRanges = np.ascontiguousarray(lambdaRanges, dtype=np.float64)
+
+    if len(arc_offsets) != numGraphs + 1 or len(sources) != numGraphs or len(sinks) != numGraphs:
+        raise ValueError("arc_offsets should have one more entry than num_nodes, sources and sinks one per graph.")
+    if lambdaRanges.shape != (numGraphs, 2):
+        raise ValueError("lambdaRanges should have one (lower, upper) row per graph.")
+    numArcs = int(arc_offsets[-1]) if numGraphs > 0 else 0
+    if len(from_nodes) < numArcs or len(to_nodes) < numArcs or len(const_cap) < numArcs:
+        raise ValueError("from_nodes, to_nodes and const_cap should have arc_offsets[-1] entries.")
+    if mult_cap is not None:
+        mult_cap = np.ascontiguousarray(mult_cap, dtype=np.float64)
+        if len(mult_cap) < numArcs:
+            raise ValueError("mult_cap should have the same length as const_cap.")
+
+    c_breakpointOffsets = POINTER(c_longlong)()
+    c_breakpoints = POINTER(c_double)()
+    c_cutOffsets = POINTER(c_longlong)()
+    c_cuts = POINTER(c_int)()
+    stats = np.zeros((numGraphs, 5), dtype=np.intc)
+
+    _hpf_solve_batch(
+        numGraphs,
+        num_nodes.ctypes.data_as(POINTER(c_int)),
+        arc_offsets.ctypes.data_as(POINTER(c_int)),
+        sources.ctypes.data_as(POINTER(c_int)),
+        sinks.ctypes.data_as(POINTER(c_int)),
+        from_nodes.ctypes.data_as(POINTER(c_int)),
+        to_nodes.ctypes.data_as(POINTER(c_int)),
+        const_cap.ctypes.data_as(POINTER(c_double)),
+        None if mult_cap is None else mult_cap.ctypes.data_as(POINTER(c_double)),
+        lambdaRanges.ctypes.data_as(POINTER(c_double)),
+        1 if roundNegativeCapacity else 0,
+        numThreads,
+        byref(c_breakpointOffsets),
+        byref(c_breakpoints),
+        byref(c_cutOffsets),
+        byref(c_cuts),
+        stats.ctypes.data_as(POINTER(c_int)),
+    )
+
+    breakpoint_offsets = _wrap_c_array(np, c_breakpointOffsets, (numGraphs + 1,))
+    cut_offsets = _wrap_c_array(np, c_cutOffsets, (numGraphs + 1,))
+    breakpoints = _wrap_c_array(np, c_breakpoints, (max(int(breakpoint_offsets[-1]), 1),))[: breakpoint_offsets[-1]]
+    cuts = _wrap_c_array(np, c_cuts, (max(int(cut_offsets[-1]), 1),))[: cut_offsets[-1]]
+
+    return breakpoints, breakpoint_offsets, cuts, cut_offsets, stats
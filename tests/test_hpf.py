@@ -92,6 +92,176 @@ def test_hpf_with_parametric_sink_arcs():
     }
 
 
+def test_hpf_compact_cuts():
+    from pseudoflow import hpf
+
+    digraph = nx.DiGraph()
+
+    digraph.add_edge("s", 0, const=-20, mult=20)
+    digraph.add_edge("s", 1, const=-14, mult=20)
+    digraph.add_edge("s", 2, const=-6, mult=20)
+
+    digraph.add_edge(0, "t", const=20, mult=-20)
+    digraph.add_edge(1, "t", const=14, mult=-20)
+    digraph.add_edge(2, "t", const=6, mult=-20)
+
+    digraph.add_edge(0, 1, const=2, mult=0)
+    digraph.add_edge(0, 2, const=1, mult=0)
+    digraph.add_edge(2, 1, const=3, mult=0)
+
+    breakpoints, cuts, info = hpf(
+        digraph,
+        "s",
+        "t",
+        const_cap="const",
+        mult_cap="mult",
+        lambdaRange=[0.0, 1.0001],
+        roundNegativeCapacity=True,
+        compactCuts=True,
+    )
+
+    assert breakpoints == pytest.approx([0.45, 0.55, 1.0, 1.0001])
+    assert cuts == {"s": 0, 0: 3, 1: 2, 2: 1, "t": 4}
+
+
+def test_hpf_lambdas():
+    from pseudoflow import hpf
+
+    digraph = nx.DiGraph()
+
+    digraph.add_edge("s", 0, const=-20, mult=20)
+    digraph.add_edge("s", 1, const=-14, mult=20)
+    digraph.add_edge("s", 2, const=-6, mult=20)
+
+    digraph.add_edge(0, "t", const=20, mult=-20)
+    digraph.add_edge(1, "t", const=14, mult=-20)
+    digraph.add_edge(2, "t", const=6, mult=-20)
+
+    digraph.add_edge(0, 1, const=2, mult=0)
+    digraph.add_edge(0, 2, const=1, mult=0)
+    digraph.add_edge(2, 1, const=3, mult=0)
+
+    breakpoints, cuts, info = hpf(
+        digraph,
+        "s",
+        "t",
+        const_cap="const",
+        mult_cap="mult",
+        roundNegativeCapacity=True,
+        lambdas=[0.3, 0.5, 0.7, 1.0001],
+    )
+
+    assert breakpoints == pytest.approx([0.3, 0.5, 0.7, 1.0001])
+    assert cuts == {
+        "s": [1, 1, 1, 1],
+        0: [0, 0, 0, 1],
+        1: [0, 0, 1, 1],
+        2: [0, 1, 1, 1],
+        "t": [0, 0, 0, 0],
+    }
+
+    with pytest.raises(ValueError):
+        hpf(digraph, "s", "t", const_cap="const", mult_cap="mult", lambdas=[0.5, 0.3])
+
+
+def test_hpf_arrays():
+    np = pytest.importorskip("numpy")
+    from pseudoflow import hpf_arrays
+
+    # the graph of test_hpf_with_parametric_sink_arcs, s = 3 and t = 4.
+    from_nodes = np.array([3, 3, 3, 0, 1, 2, 0, 0, 2])
+    to_nodes = np.array([0, 1, 2, 4, 4, 4, 1, 2, 1])
+    const_cap = np.array([-20, -14, -6, 20, 14, 6, 2, 1, 3], dtype=np.float64)
+    mult_cap = np.array([20, 20, 20, -20, -20, -20, 0, 0, 0], dtype=np.float64)
+
+    breakpoints, cuts, info = hpf_arrays(
+        from_nodes,
+        to_nodes,
+        const_cap,
+        mult_cap,
+        source=3,
+        sink=4,
+        lambdaRange=[0.0, 1.0001],
+        roundNegativeCapacity=True,
+    )
+
+    assert list(breakpoints) == pytest.approx([0.45, 0.55, 1.0, 1.0001])
+    assert cuts.shape == (4, 5)
+    assert cuts[:, 0].tolist() == [0, 0, 0, 1]
+    assert cuts[:, 2].tolist() == [0, 1, 1, 1]
+    assert cuts[:, 3].tolist() == [1, 1, 1, 1]
+
+    _, compact, _ = hpf_arrays(
+        from_nodes,
+        to_nodes,
+        const_cap,
+        mult_cap,
+        source=3,
+        sink=4,
+        lambdaRange=[0.0, 1.0001],
+        roundNegativeCapacity=True,
+        compactCuts=True,
+    )
+
+    assert compact.tolist() == [3, 2, 1, 0, 4]
+
+
+def test_hpf_batch():
+    np = pytest.importorskip("numpy")
+    from pseudoflow import hpf_batch
+
+    # the graph of test_hpf_arrays twice, the second time over a shorter range.
+    from_nodes = np.tile([3, 3, 3, 0, 1, 2, 0, 0, 2], 2)
+    to_nodes = np.tile([0, 1, 2, 4, 4, 4, 1, 2, 1], 2)
+    const_cap = np.tile([-20, -14, -6, 20, 14, 6, 2, 1, 3], 2).astype(np.float64)
+    mult_cap = np.tile([20, 20, 20, -20, -20, -20, 0, 0, 0], 2).astype(np.float64)
+
+    breakpoints, breakpoint_offsets, cuts, cut_offsets, stats = hpf_batch(
+        num_nodes=[5, 5],
+        arc_offsets=[0, 9, 18],
+        sources=[3, 3],
+        sinks=[4, 4],
+        from_nodes=from_nodes,
+        to_nodes=to_nodes,
+        const_cap=const_cap,
+        mult_cap=mult_cap,
+        lambdaRanges=[[0.0, 1.0001], [0.0, 0.5]],
+        roundNegativeCapacity=True,
+        numThreads=2,
+    )
+
+    assert breakpoint_offsets.tolist() == [0, 4, 6]
+    assert cut_offsets.tolist() == [0, 20, 30]
+    assert list(breakpoints) == pytest.approx([0.45, 0.55, 1.0, 1.0001, 0.45, 0.5])
+    first = cuts[cut_offsets[0] : cut_offsets[1]].reshape(4, 5)
+    assert first[:, 2].tolist() == [0, 1, 1, 1]
+    second = cuts[cut_offsets[1] : cut_offsets[2]].reshape(2, 5)
+    assert second[:, 0].tolist() == [0, 0]
+    assert second[:, 2].tolist() == [0, 1]
+    assert stats.shape == (2, 5)
+
+
+def test_native_extension():
+    _hpf = pytest.importorskip("pseudoflow._hpf")
+
+    # the graph of test_hpf_parametric, nodes s = 0, 1 and t = 2.
+    arcMatrix = [0, 1, 1, 5, 1, 2, 9, -3]
+
+    breakpoints, cuts, stats, times = _hpf.solve(
+        ["s", 1, "t"], 0, 2, arcMatrix, (0.0, 2.0), False, False
+    )
+
+    assert breakpoints == [1.0, 2.0]
+    assert cuts == {"s": [1, 1], 1: [0, 1], "t": [0, 0]}
+    assert len(stats) == 5 and len(times) == 3
+
+    _, compact, _, _ = _hpf.solve(["s", 1, "t"], 0, 2, arcMatrix, (0.0, 2.0), False, True)
+    assert compact == {"s": 0, 1: 1, "t": 2}
+
+    with pytest.raises(ValueError):
+        _hpf.solve(["s", 1, "t"], 0, 2, arcMatrix[:7], (0.0, 2.0), False, False)
+
+
 def test_missing_breakpoint():
     G = nx.DiGraph()
 
@@ -139,6 +309,182 @@ def test_missing_breakpoint():
     }
 
 
+def test_breakpoint_at_intersection():
+    # the cut lines of the problems at 0 and 10 intersect at the breakpoint
+    # 3.5, the search used to stop there and miss 2 and 5
+    G = nx.DiGraph()
+
+    G.add_edge("s", 0, constant=-7, multiplier=2)
+    G.add_edge("s", 1, constant=-5, multiplier=1)
+    G.add_edge("s", 2, constant=-2, multiplier=1)
+    G.add_edge(0, "t", constant=7, multiplier=-2)
+    G.add_edge(1, "t", constant=5, multiplier=-1)
+    G.add_edge(2, "t", constant=2, multiplier=-1)
+
+    G.add_edge(0, 2, constant=4, multiplier=0)
+    G.add_edge(1, 2, constant=5, multiplier=0)
+
+    breakpoints, cuts, _ = hpf(
+        G,
+        "s",
+        "t",
+        const_cap="constant",
+        mult_cap="multiplier",
+        lambdaRange=[0.0, 10.0],
+        roundNegativeCapacity=True,
+    )
+    assert breakpoints == pytest.approx([2.0, 3.5, 5.0, 10.0])
+    assert cuts == {
+        "s": [1, 1, 1, 1],
+        "t": [0, 0, 0, 0],
+        0: [0, 0, 1, 1],
+        1: [0, 0, 0, 1],
+        2: [0, 1, 1, 1],
+    }
+
+
+def _solve_context(arcs, numNodes, source, sink, lambdaRange, options={}, flowLambda=None, roundNegativeCapacity=False):
+    """Solves the (from, to, constant, multiplier) rows of arcs on a libhpf
+    context with the given options. Returns the breakpoints, the source set
+    indicators of every breakpoint, the cut values if HPF_OPTION_CUT_VALUES
+    is set and the flow of every arc at flowLambda if it is given."""
+    from ctypes import POINTER, byref, c_double, c_int, cast
+    from pseudoflow.python import hpf as hpf_module
+
+    arcMatrix = (c_double * (4 * len(arcs)))(*[value for arc in arcs for value in arc])
+    numBreakpoints = c_int()
+    cuts = POINTER(c_int)()
+    breakpoints = POINTER(c_double)()
+
+    ctx = hpf_module._hpf_context_create()
+    for option, value in options.items():
+        hpf_module._hpf_context_set_option(ctx, option, value)
+    if flowLambda is not None:
+        hpf_module._hpf_context_set_flow_lambda(ctx, byref(c_double(flowLambda)))
+    hpf_module._hpf_context_solve(
+        ctx,
+        numNodes,
+        len(arcs),
+        source,
+        sink,
+        cast(arcMatrix, POINTER(c_double)),
+        (c_double * 2)(*lambdaRange),
+        1 if roundNegativeCapacity else 0,
+        byref(numBreakpoints),
+        byref(cuts),
+        byref(breakpoints),
+        (c_int * 5)(),
+        (c_double * 3)(),
+    )
+
+    cutValues = hpf_module._hpf_context_get_cut_values(ctx)
+    flows = hpf_module._hpf_context_get_flows(ctx)
+    n = numBreakpoints.value
+    result = (
+        [breakpoints[k] for k in range(n)],
+        [[cuts[numNodes * k + i] for i in range(numNodes)] for k in range(n)],
+        [cutValues[k] for k in range(n)] if cutValues else None,
+        [flows[a] for a in range(len(arcs))] if flows else None,
+    )
+    hpf_module._hpf_context_destroy(ctx)
+    hpf_module.libhpf.libfree(breakpoints)
+    hpf_module.libhpf.libfree(cuts)
+    return result
+
+
+def test_exact_capacities():
+    from pseudoflow.python.hpf import HPF_OPTION_EXACT_CAPACITIES
+
+    # nodes 1 and 2 leave the sink set at 1 / 10001 and 1 / 10000, which
+    # only the integral capacities of the exact mode tell apart
+    G = nx.DiGraph()
+
+    G.add_edge("s", 1, constant=0, multiplier=10000)
+    G.add_edge(1, "t", constant=1, multiplier=0)
+    G.add_edge("s", 2, constant=0, multiplier=10001)
+    G.add_edge(2, "t", constant=1, multiplier=0)
+
+    breakpoints, cuts, _ = hpf(
+        G,
+        "s",
+        "t",
+        const_cap="constant",
+        mult_cap="multiplier",
+        lambdaRange=[0.0, 1.0],
+    )
+    assert breakpoints == pytest.approx([1 / 10001, 1 / 10000, 1.0])
+    assert cuts == {"s": [1, 1, 1], 1: [0, 0, 1], 2: [0, 1, 1], "t": [0, 0, 0]}
+
+    # s = 0, 1, 2 and t = 3, without the exact mode the two merge
+    arcs = [(0, 1, 0, 10000), (1, 3, 1, 0), (0, 2, 0, 10001), (2, 3, 1, 0)]
+    exact, _, _, _ = _solve_context(arcs, 4, 0, 3, [0.0, 1.0])
+    assert exact == pytest.approx([1 / 10001, 1 / 10000, 1.0])
+    inexact, _, _, _ = _solve_context(arcs, 4, 0, 3, [0.0, 1.0], {HPF_OPTION_EXACT_CAPACITIES: 0})
+    assert len(inexact) == 2 and inexact[1] == 1.0
+
+
+def test_exact_capacities_fallback():
+    from pseudoflow.python.hpf import HPF_OPTION_EXACT_CAPACITIES
+
+    # the capacities are integers, but scaled by the denominator 10^7 + 1 of
+    # the first breakpoint they exceed 2^53, so the exact mode falls back to
+    # the tolerance of the inexact search
+    arcs = [(0, 1, 0, 10**7), (1, 3, 10**9, 0), (0, 2, 0, 10**7 + 1), (2, 3, 10**9, 0)]
+    assert (10**7 + 1) * 2 * 10**9 > 2**53
+
+    exact, _, _, _ = _solve_context(arcs, 4, 0, 3, [0.0, 150.0])
+    inexact, _, _, _ = _solve_context(arcs, 4, 0, 3, [0.0, 150.0], {HPF_OPTION_EXACT_CAPACITIES: 0})
+    assert exact == inexact
+    assert exact == pytest.approx([10**9 / (10**7 + 1), 100.0, 150.0])
+
+
+def test_cut_values_and_flows():
+    from pseudoflow.python.hpf import HPF_OPTION_CUT_VALUES
+
+    # s = 0 and t = 5, the flow at every lambda uses most of the arcs
+    arcs = [
+        (0, 1, 0, 3),
+        (0, 2, 2, 1),
+        (1, 3, 4, 0),
+        (1, 4, 2, 0),
+        (2, 4, 3, 0),
+        (2, 1, 1, 0),
+        (3, 4, 1, 0),
+        (3, 5, 5, 0),
+        (4, 5, 6, -1),
+    ]
+
+    def capacity(arc, lambdaValue):
+        return arc[2] + lambdaValue * arc[3]
+
+    def cutCapacity(sourceSet, lambdaValue):
+        return sum(capacity(arc, lambdaValue) for arc in arcs if sourceSet[arc[0]] and not sourceSet[arc[1]])
+
+    breakpoints, cuts, cutValues, flows = _solve_context(arcs, 6, 0, 5, [0.0, 4.0], {HPF_OPTION_CUT_VALUES: 1})
+    assert breakpoints == pytest.approx([1.6, 4.0])
+    assert cutValues == pytest.approx([8.4, 6.0])
+    assert flows is None
+    for breakpoint, cut, cutValue in zip(breakpoints, cuts, cutValues):
+        assert cutValue == pytest.approx(cutCapacity(cut, breakpoint))
+
+    for flowLambda in [0.5, 1.5, 2.5, 3.5]:
+        _, _, cutValues, flows = _solve_context(arcs, 6, 0, 5, [0.0, 4.0], flowLambda=flowLambda)
+        assert cutValues is None
+        for arc, flow in zip(arcs, flows):
+            assert -1e-9 <= flow <= capacity(arc, flowLambda) + 1e-9
+
+        excess = [0.0] * 6
+        for arc, flow in zip(arcs, flows):
+            excess[arc[0]] -= flow
+            excess[arc[1]] += flow
+        assert excess[1:5] == pytest.approx([0.0, 0.0, 0.0, 0.0])
+
+        # the value of the flow is the capacity of the minimum cut at its lambda
+        _, minimumCuts, _, _ = _solve_context(arcs, 6, 0, 5, [flowLambda, flowLambda])
+        assert excess[5] == pytest.approx(cutCapacity(minimumCuts[-1], flowLambda))
+        assert -excess[0] == pytest.approx(excess[5])
+
+
 def test_problem1():
     is_training_dict = {
         0: True,